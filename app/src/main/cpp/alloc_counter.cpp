@@ -0,0 +1,85 @@
+// All code comments are in English per repo policy.
+
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+constexpr std::size_t kShardCount = 64;
+
+struct alignas(64) counter_shard {
+    std::atomic<std::uint64_t> value{0};
+};
+
+counter_shard g_shards[kShardCount];
+std::atomic<std::size_t> g_next_shard{0};
+
+// Each thread picks a shard once; round-robin keeps threads of a pool on distinct cache lines.
+std::size_t this_thread_shard() noexcept {
+    thread_local const std::size_t shard = g_next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+    return shard;
+}
+
+void count_allocation() noexcept {
+    g_shards[this_thread_shard()].value.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+namespace alloc_counter {
+
+std::uint64_t allocations() noexcept {
+    std::uint64_t total = 0;
+    for (auto &shard : g_shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+} // namespace alloc_counter
+
+// Array and nothrow forms of operator new forward to these in both libc++ and libstdc++.
+void *operator new(std::size_t size) {
+    count_allocation();
+    if (size == 0) size = 1;
+    for (;;) {
+        if (void *p = std::malloc(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    count_allocation();
+    if (size == 0) size = 1;
+    auto align = static_cast<std::size_t>(alignment);
+    if (align < sizeof(void *)) align = sizeof(void *);
+    for (;;) {
+        void *p = nullptr;
+        if (::posix_memalign(&p, align, size) == 0) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
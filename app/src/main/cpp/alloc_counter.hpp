@@ -0,0 +1,14 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <cstdint>
+
+// Process-wide heap allocation counter.
+// Linking alloc_counter.cpp replaces the global operator new/delete with malloc/free based versions that count every
+// allocation. Counters are sharded per thread so multi-threaded benchmarks do not contend on a single cache line.
+namespace alloc_counter {
+
+// Total number of operator new calls since process start (all threads).
+std::uint64_t allocations() noexcept;
+
+} // namespace alloc_counter
@@ -0,0 +1,159 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/cpu_affinity.hpp"
+
+#include <coro/coro.hpp>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Unpinned vs pinned scheduler threads (coro_ext::cpu_placement), sized to the performance cores of this device:
+//  - throughput: one task fans out kFanOutLeaves leaves on a coro::thread_pool whose workers float freely vs are
+//    pinned one per performance core;
+//  - latency: an outside thread signals an eventfd kRounds times, one round at a time, and a coroutine on a
+//    coro::io_scheduler (tasks on its thread pool) records the time from the write to the moment it runs. The pinned
+//    run keeps the event thread and the pool on one performance cluster via coro_ext::place(). p50/p99/max reported.
+// On a homogeneous single-package host both placements cover the same CPUs, so only migration costs differ.
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t kFanOutLeaves = 10'000;
+constexpr std::size_t kRounds = 2'000;
+
+std::uint32_t performance_core_count() {
+    const std::size_t count = coro_ext::cpu_topology::system().performance_cpus().size();
+    return static_cast<std::uint32_t>(std::max<std::size_t>(1, count));
+}
+
+std::string cpu_list(const std::vector<int> &cpus) {
+    std::string out;
+    for (const int cpu : cpus) out += (out.empty() ? "" : ",") + std::to_string(cpu);
+    return out;
+}
+
+coro::task<void> fan_out_leaf(coro::thread_pool &pool, std::atomic<std::uint64_t> &counter) {
+    co_await pool.schedule();
+    counter.fetch_add(1, std::memory_order_relaxed);
+    co_return;
+}
+
+coro::task<void> fan_out_root(coro::thread_pool &pool, std::atomic<std::uint64_t> &counter) {
+    co_await pool.schedule();
+    std::vector<coro::task<void>> tasks;
+    tasks.reserve(kFanOutLeaves);
+    for (std::size_t i = 0; i < kFanOutLeaves; ++i) tasks.emplace_back(fan_out_leaf(pool, counter));
+    co_await coro::when_all(std::move(tasks));
+    co_return;
+}
+
+void bench_fan_out(const coro_ext::cpu_placement &placement, const std::string &name) {
+    coro::thread_pool pool{coro::thread_pool::options{
+        .thread_count = performance_core_count(),
+        .on_thread_start_functor = coro_ext::thread_start_functor(placement)}};
+    std::atomic<std::uint64_t> counter{0};
+    BENCHMARK(name.c_str()) {
+        counter.store(0, std::memory_order_relaxed);
+        coro::sync_wait(fan_out_root(pool, counter));
+        return counter.load(std::memory_order_relaxed);
+    };
+    REQUIRE(counter.load() == kFanOutLeaves);
+}
+
+// One signal in flight at a time: the signaller waits for `acked` before timing the next write.
+struct wake_channel {
+    int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    std::atomic<clock_type::rep> sent{0};
+    std::atomic<std::uint64_t> acked{0};
+
+    wake_channel() = default;
+    wake_channel(const wake_channel &) = delete;
+    wake_channel &operator=(const wake_channel &) = delete;
+    ~wake_channel() {
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+coro::task<void> wake_receiver(std::shared_ptr<coro::io_scheduler> scheduler, wake_channel &channel,
+                               std::vector<double> &samples_us) {
+    co_await scheduler->schedule();
+    for (std::size_t i = 0; i < kRounds; ++i) {
+        std::uint64_t value = 0;
+        while (::read(channel.fd, &value, sizeof(value)) != sizeof(value)) {
+            if (co_await scheduler->poll(channel.fd, coro::poll_op::read) != coro::poll_status::event) co_return;
+        }
+        const auto sent = clock_type::time_point{clock_type::duration{channel.sent.load(std::memory_order_acquire)}};
+        samples_us.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - sent).count());
+        channel.acked.fetch_add(1, std::memory_order_release);
+        channel.acked.notify_one();
+    }
+    co_return;
+}
+
+void measure_wake_latency(const coro_ext::cpu_placement &placement, const std::string &label) {
+    coro::io_scheduler::options opts{};
+    opts.pool.thread_count = performance_core_count();
+    auto scheduler = coro::io_scheduler::make_shared(coro_ext::place(std::move(opts), placement));
+    wake_channel channel;
+    REQUIRE(channel.fd >= 0);
+    std::vector<double> samples_us;
+    samples_us.reserve(kRounds);
+
+    std::thread signaller{[&channel] {
+        for (std::uint64_t i = 0; i < kRounds; ++i) {
+            channel.sent.store(clock_type::now().time_since_epoch().count(), std::memory_order_release);
+            const std::uint64_t one = 1;
+            if (::write(channel.fd, &one, sizeof(one)) != sizeof(one)) return;
+            channel.acked.wait(i, std::memory_order_acquire);
+        }
+    }};
+    coro::sync_wait(wake_receiver(scheduler, channel, samples_us));
+    signaller.join();
+    REQUIRE(samples_us.size() == kRounds);
+
+    std::sort(samples_us.begin(), samples_us.end());
+    const auto at = [&](double q) {
+        return samples_us[std::min(samples_us.size() - 1, static_cast<std::size_t>(q * samples_us.size()))];
+    };
+    std::cout << "[cpu_affinity] " << label << ": " << kRounds << " wake-ups, latency p50 " << at(0.5) << " us, p99 "
+              << at(0.99) << " us, max " << samples_us.back() << " us\n";
+}
+
+} // namespace
+
+TEST_CASE("cpu_affinity pinned vs unpinned task throughput", "[bench][cpu_affinity]") {
+    const auto &topology = coro_ext::cpu_topology::system();
+    REQUIRE(!topology.cpus().empty());
+    std::cout << "[cpu_affinity] cpus " << cpu_list(topology.all_cpus()) << ", performance cores "
+              << cpu_list(topology.performance_cpus()) << ", performance cluster "
+              << cpu_list(topology.performance_cluster())
+              << (topology.heterogeneous() ? " (heterogeneous)" : " (homogeneous)") << "\n";
+
+    const std::string suffix = ": fan-out " + std::to_string(kFanOutLeaves) + " tasks, " +
+                               std::to_string(performance_core_count()) + " threads";
+    bench_fan_out(coro_ext::cpu_placement{}, "thread_pool, unpinned" + suffix);
+    bench_fan_out(coro_ext::cpu_placement{.kind = coro_ext::cpu_placement::policy::performance_cores,
+                                          .cpus = {},
+                                          .one_cpu_per_thread = true},
+                  "thread_pool, one thread per performance core" + suffix);
+}
+
+TEST_CASE("cpu_affinity pinned vs unpinned wake-up latency", "[bench][cpu_affinity]") {
+    measure_wake_latency(coro_ext::cpu_placement{}, "io_scheduler, unpinned");
+    measure_wake_latency(coro_ext::cpu_placement{.kind = coro_ext::cpu_placement::policy::performance_cluster,
+                                                 .cpus = {}},
+                         "io_scheduler, event thread + pool on the performance cluster");
+}
@@ -0,0 +1,207 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/frame_allocator.hpp"
+#include "coro_ext/work_stealing_pool.hpp"
+
+#include <coro/coro.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Coroutine frame allocation: global operator new vs coro_ext::frame_allocator.
+// coro::task's promise lives in the libcoro submodule, so the comparison uses a minimal lazy task (same shape as
+// coro::task: initial suspend, symmetric transfer to the continuation) whose promise optionally derives from
+// coro_ext::pooled_frame. Only the frame allocation differs between the two variants.
+
+namespace {
+
+struct default_frame {};
+
+template <typename allocation>
+class bench_task {
+public:
+    struct promise_type : allocation {
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+        std::uint64_t value = 0;
+
+        bench_task get_return_object() noexcept {
+            return bench_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept {
+            struct final_awaiter {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                    return h.promise().continuation;
+                }
+                void await_resume() noexcept {}
+            };
+            return final_awaiter{};
+        }
+        void return_value(std::uint64_t v) noexcept { value = v; }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    bench_task(bench_task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    bench_task(const bench_task &) = delete;
+    ~bench_task() {
+        if (handle_) handle_.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+        handle_.promise().continuation = continuation;
+        return handle_;
+    }
+    std::uint64_t await_resume() const noexcept { return handle_.promise().value; }
+
+    // Runs a task that completes synchronously (no scheduler involved).
+    std::uint64_t run() {
+        handle_.resume();
+        return handle_.promise().value;
+    }
+
+private:
+    explicit bench_task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+    std::coroutine_handle<promise_type> handle_;
+};
+
+constexpr std::size_t kChildTasks = 10'000;
+constexpr std::size_t kLiveFrames = 200'000;
+constexpr std::uint32_t kPoolThreads = 4;
+
+template <typename allocation>
+bench_task<allocation> leaf(std::uint64_t i) {
+    co_return i & 1;
+}
+
+template <typename allocation>
+bench_task<allocation> parent(std::size_t children) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < children; ++i) sum += co_await leaf<allocation>(i);
+    co_return sum;
+}
+
+// Each leaf hops onto the pool; when another worker picks it up, its frame is freed on a different thread than the
+// one that allocated it, exercising the cross-thread free path.
+template <typename allocation>
+bench_task<allocation> pool_leaf(coro_ext::work_stealing_pool &pool) {
+    co_await pool.schedule();
+    co_return 1;
+}
+
+template <typename allocation>
+bench_task<allocation> pool_parent(coro_ext::work_stealing_pool &pool, std::size_t children) {
+    co_await pool.schedule();
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < children; ++i) sum += co_await pool_leaf<allocation>(pool);
+    co_return sum;
+}
+
+template <typename allocation>
+void bench_sequential(const char *name) {
+    std::uint64_t result = 0;
+    BENCHMARK(name) {
+        result = parent<allocation>(kChildTasks).run();
+        return result;
+    };
+    REQUIRE(result == kChildTasks / 2);
+}
+
+template <typename allocation>
+void bench_thread_pool(const char *name) {
+    coro_ext::work_stealing_pool pool{coro_ext::work_stealing_pool::options{.thread_count = kPoolThreads}};
+    std::uint64_t result = 0;
+    BENCHMARK(name) {
+        result = coro::sync_wait(pool_parent<allocation>(pool, kChildTasks));
+        return result;
+    };
+    REQUIRE(result == kChildTasks);
+}
+
+long rss_kib() {
+    std::FILE *f = std::fopen("/proc/self/status", "r");
+    if (!f) return 0;
+    char line[256];
+    long rss = 0;
+    while (std::fgets(line, sizeof(line), f)) {
+        if (std::strncmp(line, "VmRSS:", 6) == 0) rss = std::strtol(line + 6, nullptr, 10);
+    }
+    std::fclose(f);
+    return rss;
+}
+
+// Keeps kLiveFrames suspended frames alive at once on a fresh thread and returns the RSS growth in bytes. The thread
+// exits afterwards, so frame_allocator::trim() can release every chunk it carved from.
+template <typename allocation>
+long live_frames_rss_bytes() {
+    long growth = 0;
+    std::thread{[&growth] {
+        std::vector<bench_task<allocation>> frames;
+        frames.reserve(kLiveFrames);
+        const long before = rss_kib();
+        for (std::size_t i = 0; i < kLiveFrames; ++i) frames.push_back(leaf<allocation>(i));
+        growth = (rss_kib() - before) * 1024;
+    }}.join();
+    return growth;
+}
+
+// Records the frame size the compiler requests for leaf().
+struct frame_size_probe {
+    static inline std::size_t size = 0;
+    static void *operator new(std::size_t n) {
+        size = n;
+        return ::operator new(n);
+    }
+    static void operator delete(void *ptr, std::size_t n) noexcept { ::operator delete(ptr, n); }
+};
+
+} // namespace
+
+TEST_CASE("frame_allocator sequential child tasks", "[bench][frame_allocator]") {
+    bench_sequential<default_frame>("coroutine frames, global operator new: 10000 child tasks");
+    bench_sequential<coro_ext::pooled_frame>("coroutine frames, frame_allocator: 10000 child tasks");
+}
+
+TEST_CASE("frame_allocator tasks across pool threads", "[bench][frame_allocator]") {
+    bench_thread_pool<default_frame>("coroutine frames, global operator new: 10000 pool hops on 4 workers");
+    bench_thread_pool<coro_ext::pooled_frame>("coroutine frames, frame_allocator: 10000 pool hops on 4 workers");
+}
+
+TEST_CASE("frame_allocator RSS with many live frames", "[bench][frame_allocator]") {
+    { auto probe = leaf<frame_size_probe>(0); }
+    const std::size_t frame_size = frame_size_probe::size;
+    REQUIRE(frame_size > 0);
+    REQUIRE(frame_size <= 512); // small size classes: rounded up to 16 bytes
+
+    const std::size_t reserved_before = coro_ext::frame_allocator::reserved_bytes();
+    const long pooled_rss = live_frames_rss_bytes<coro_ext::pooled_frame>();
+    const std::size_t arena = coro_ext::frame_allocator::reserved_bytes() - reserved_before;
+    const long default_rss = live_frames_rss_bytes<default_frame>();
+    INFO("frame " << frame_size << " B, " << kLiveFrames << " live frames: frame_allocator +" << pooled_rss / 1024
+                  << " KiB RSS (" << arena / 1024 << " KiB arena), global operator new +" << default_rss / 1024
+                  << " KiB RSS");
+
+    // No per-frame header: the arena holds the frames at their 16-byte class size, in whole chunks.
+    const std::size_t block = (frame_size + 15) / 16 * 16;
+    const std::size_t per_chunk = (coro_ext::frame_allocator::chunk_size - 16) / block;
+    CHECK(arena <= (kLiveFrames + per_chunk - 1) / per_chunk * coro_ext::frame_allocator::chunk_size);
+    // RSS follows the arena; the rest is the handle vector plus 1 MiB of slack for unrelated allocations.
+    const long handles = static_cast<long>(kLiveFrames * sizeof(bench_task<coro_ext::pooled_frame>));
+    CHECK(pooled_rss <= static_cast<long>(arena) + handles + 1024 * 1024);
+
+    // Every frame is freed and the thread has exited, so all its chunks go back to the system.
+    CHECK(coro_ext::frame_allocator::trim() >= arena);
+    CHECK(coro_ext::frame_allocator::reserved_bytes() <= reserved_before);
+}
@@ -0,0 +1,152 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/mpmc_ring_buffer.hpp"
+
+#include <coro/coro.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Producer/consumer throughput through a bounded buffer, N producers and N consumers (N = 1/2/4/8) on one
+// coro::thread_pool:
+//  - coro::ring_buffer: mutex + waiter list on every produce/consume;
+//  - coro_ext::mpmc_ring_buffer: lock-free produce()/consume(), one element per operation;
+//  - coro_ext::mpmc_ring_buffer batched: produce_batch()/consume_batch() with kBatch elements per operation.
+// Every run moves kItems values and checks their sum on the consumer side.
+
+namespace {
+
+constexpr std::size_t kCapacity = 1024;
+constexpr std::size_t kItems = 1 << 16;
+constexpr std::size_t kBatch = 32;
+constexpr std::uint64_t kExpectedSum = std::uint64_t{kItems} * (kItems - 1) / 2;
+
+using locked_ring = coro::ring_buffer<std::uint64_t, kCapacity>;
+using lock_free_ring = coro_ext::mpmc_ring_buffer<std::uint64_t, kCapacity>;
+
+// --- coro::ring_buffer ---
+
+coro::task<void> locked_producer(coro::thread_pool &tp, locked_ring &rb, std::uint64_t begin, std::uint64_t end) {
+    co_await tp.schedule();
+    for (std::uint64_t v = begin; v < end; ++v) (void)co_await rb.produce(v);
+    co_return;
+}
+
+// Consumers claim items from a shared budget up front, so none of them blocks once everything has been consumed.
+coro::task<void> locked_consumer(coro::thread_pool &tp, locked_ring &rb, std::atomic<std::int64_t> &budget,
+                                 std::atomic<std::uint64_t> &sum) {
+    co_await tp.schedule();
+    std::uint64_t local = 0;
+    while (budget.fetch_sub(1, std::memory_order_relaxed) > 0) {
+        auto value = co_await rb.consume();
+        if (value.has_value()) local += value.value();
+    }
+    sum.fetch_add(local, std::memory_order_relaxed);
+    co_return;
+}
+
+// --- coro_ext::mpmc_ring_buffer ---
+
+// The last producer to finish shuts the buffer down; consumers drain it and stop.
+void finish_producer(lock_free_ring &rb, std::atomic<std::size_t> &producers_left) {
+    if (producers_left.fetch_sub(1, std::memory_order_acq_rel) == 1) rb.shutdown();
+}
+
+coro::task<void> lock_free_producer(coro::thread_pool &tp, lock_free_ring &rb, std::uint64_t begin, std::uint64_t end,
+                                    std::atomic<std::size_t> &producers_left) {
+    co_await tp.schedule();
+    for (std::uint64_t v = begin; v < end; ++v) (void)co_await rb.produce(v);
+    finish_producer(rb, producers_left);
+    co_return;
+}
+
+coro::task<void> lock_free_consumer(coro::thread_pool &tp, lock_free_ring &rb, std::atomic<std::uint64_t> &sum) {
+    co_await tp.schedule();
+    std::uint64_t local = 0;
+    while (auto value = co_await rb.consume()) local += *value;
+    sum.fetch_add(local, std::memory_order_relaxed);
+    co_return;
+}
+
+coro::task<void> batch_producer(coro::thread_pool &tp, lock_free_ring &rb, std::uint64_t begin, std::uint64_t end,
+                                std::atomic<std::size_t> &producers_left) {
+    co_await tp.schedule();
+    std::array<std::uint64_t, kBatch> batch{};
+    for (std::uint64_t v = begin; v < end;) {
+        std::size_t n = 0;
+        while (n < batch.size() && v < end) batch[n++] = v++;
+        (void)co_await rb.produce_batch(std::span<std::uint64_t>{batch.data(), n});
+    }
+    finish_producer(rb, producers_left);
+    co_return;
+}
+
+coro::task<void> batch_consumer(coro::thread_pool &tp, lock_free_ring &rb, std::atomic<std::uint64_t> &sum) {
+    co_await tp.schedule();
+    std::array<std::uint64_t, kBatch> batch{};
+    std::uint64_t local = 0;
+    while (const std::size_t n = co_await rb.consume_batch(batch)) {
+        for (std::size_t i = 0; i < n; ++i) local += batch[i];
+    }
+    sum.fetch_add(local, std::memory_order_relaxed);
+    co_return;
+}
+
+enum class variant { locked, lock_free, batched };
+
+std::uint64_t run_pipeline(coro::thread_pool &tp, variant kind, std::uint32_t pairs) {
+    std::atomic<std::uint64_t> sum{0};
+    std::vector<coro::task<void>> tasks;
+    tasks.reserve(pairs * 2);
+    const std::uint64_t share = kItems / pairs;
+    if (kind == variant::locked) {
+        locked_ring rb;
+        std::atomic<std::int64_t> budget{static_cast<std::int64_t>(kItems)};
+        for (std::uint32_t i = 0; i < pairs; ++i) {
+            tasks.emplace_back(locked_producer(tp, rb, i * share, (i + 1) * share));
+            tasks.emplace_back(locked_consumer(tp, rb, budget, sum));
+        }
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+    } else {
+        lock_free_ring rb;
+        std::atomic<std::size_t> producers_left{pairs};
+        for (std::uint32_t i = 0; i < pairs; ++i) {
+            if (kind == variant::lock_free) {
+                tasks.emplace_back(lock_free_producer(tp, rb, i * share, (i + 1) * share, producers_left));
+                tasks.emplace_back(lock_free_consumer(tp, rb, sum));
+            } else {
+                tasks.emplace_back(batch_producer(tp, rb, i * share, (i + 1) * share, producers_left));
+                tasks.emplace_back(batch_consumer(tp, rb, sum));
+            }
+        }
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+    }
+    return sum.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+TEST_CASE("mpmc_ring_buffer producer/consumer throughput", "[bench][mpmc_ring_buffer]") {
+    for (const std::uint32_t pairs : {1u, 2u, 4u, 8u}) {
+        coro::thread_pool tp{coro::thread_pool::options{.thread_count = pairs * 2}};
+        const std::string suffix = ": " + std::to_string(pairs) + "P/" + std::to_string(pairs) + "C, " +
+                                   std::to_string(kItems) + " items";
+        for (const auto &[kind, label] : {std::pair{variant::locked, "coro::ring_buffer"},
+                                          std::pair{variant::lock_free, "mpmc_ring_buffer"},
+                                          std::pair{variant::batched, "mpmc_ring_buffer batch 32"}}) {
+            std::uint64_t sum = 0;
+            BENCHMARK((std::string{label} + suffix).c_str()) {
+                sum = run_pipeline(tp, kind, pairs);
+                return sum;
+            };
+            REQUIRE(sum == kExpectedSum);
+        }
+    }
+}
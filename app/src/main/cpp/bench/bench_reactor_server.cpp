@@ -0,0 +1,228 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/reactor_server.hpp"
+#include "coro_ext/vectored_io.hpp"
+
+#include <coro/coro.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// coro_ext::reactor_server with 1..N SO_REUSEPORT reactors on loopback. Clients run on their own io_schedulers
+// (process_tasks_inline), one per reactor of the largest configuration, so the client side does not cap scaling.
+// The server handler reads a framed message (8-byte header + payload) with one coro_ext::read_exact() and echoes it
+// with one coro_ext::write_all(), until the client closes.
+//  - echo: kEchoConnections connections, each sending kEchoMessages messages and waiting for every echo;
+//  - connection rate: kConnectClients clients, each opening kConnectsPerClient connections in turn, exchanging one
+//    message and closing. Clients close with an RST (SO_LINGER 0), so repeated runs do not run out of ports on
+//    TIME_WAIT sockets.
+// How the kernel spread the connections over the reactors is printed after the connection-rate run.
+
+namespace {
+
+constexpr std::size_t kEchoConnections = 32;
+constexpr std::size_t kEchoMessages = 100;
+constexpr std::size_t kConnectClients = 16;
+constexpr std::size_t kConnectsPerClient = 20;
+constexpr std::size_t kPayloadSize = 56;
+
+using scheduler_ptr = std::shared_ptr<coro::io_scheduler>;
+
+struct frame_header {
+    std::uint32_t length = 0;
+    std::uint32_t sequence = 0;
+};
+
+constexpr std::int64_t kFrameSize = sizeof(frame_header) + kPayloadSize;
+
+struct frame {
+    frame_header header;
+    std::array<char, kPayloadSize> payload{};
+
+    std::array<std::span<char>, 2> parts() {
+        return {std::span{reinterpret_cast<char *>(&header), sizeof(header)}, std::span{payload}};
+    }
+    std::array<std::span<const char>, 2> parts() const {
+        return {std::span{reinterpret_cast<const char *>(&header), sizeof(header)}, std::span{payload}};
+    }
+};
+
+std::vector<std::uint32_t> bench_reactor_counts() {
+    const std::uint32_t hw = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<std::uint32_t> counts;
+    for (std::uint32_t n = 1; n < hw; n *= 2) counts.push_back(n);
+    counts.push_back(hw);
+    return counts;
+}
+
+std::vector<scheduler_ptr> make_client_schedulers(std::size_t count) {
+    std::vector<scheduler_ptr> schedulers;
+    for (std::size_t i = 0; i < count; ++i) {
+        schedulers.push_back(coro::io_scheduler::make_shared(coro::io_scheduler::options{
+            .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline}));
+    }
+    return schedulers;
+}
+
+coro::task<void> echo_handler(scheduler_ptr scheduler, int fd) {
+    frame f;
+    for (;;) {
+        if (co_await coro_ext::read_exact(scheduler, fd, f.parts()) != kFrameSize) co_return;
+        if (co_await coro_ext::write_all(scheduler, fd, std::as_const(f).parts()) != kFrameSize) co_return;
+    }
+}
+
+// Non-blocking connect; returns the connected socket or -errno.
+coro::task<int> connect_to(scheduler_ptr scheduler, std::uint16_t port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) co_return -errno;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    int err = 0;
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+        err = errno;
+        if (err == EINPROGRESS) {
+            err = co_await scheduler->poll(fd, coro::poll_op::write) == coro::poll_status::event ? 0 : ECONNREFUSED;
+            socklen_t len = sizeof(err);
+            if (err == 0) ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        }
+    }
+    if (err != 0) {
+        ::close(fd);
+        co_return -err;
+    }
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    co_return fd;
+}
+
+void close_with_reset(int fd) {
+    const linger abort_close{.l_onoff = 1, .l_linger = 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &abort_close, sizeof(abort_close));
+    ::close(fd);
+}
+
+// One request/response on `fd`; true when the echo came back intact.
+coro::task<bool> exchange(scheduler_ptr scheduler, int fd, std::uint32_t sequence) {
+    frame out;
+    out.header = frame_header{.length = kPayloadSize, .sequence = sequence};
+    out.payload.fill(static_cast<char>(sequence));
+    frame in;
+    if (co_await coro_ext::write_all(scheduler, fd, std::as_const(out).parts()) != kFrameSize) co_return false;
+    if (co_await coro_ext::read_exact(scheduler, fd, in.parts()) != kFrameSize) co_return false;
+    co_return in.header.sequence == sequence && in.payload == out.payload;
+}
+
+coro::task<void> open_connection(scheduler_ptr scheduler, std::uint16_t port, int &fd) {
+    co_await scheduler->schedule();
+    fd = co_await connect_to(scheduler, port);
+    co_return;
+}
+
+coro::task<void> echo_client(scheduler_ptr scheduler, int fd, std::atomic<std::uint64_t> &round_trips) {
+    co_await scheduler->schedule();
+    for (std::uint32_t i = 0; i < kEchoMessages; ++i) {
+        if (!co_await exchange(scheduler, fd, i)) co_return;
+        round_trips.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+coro::task<void> connect_client(scheduler_ptr scheduler, std::uint16_t port,
+                                std::atomic<std::uint64_t> &connections) {
+    co_await scheduler->schedule();
+    for (std::uint32_t i = 0; i < kConnectsPerClient; ++i) {
+        const int fd = co_await connect_to(scheduler, port);
+        if (fd < 0) co_return;
+        const bool ok = co_await exchange(scheduler, fd, i);
+        close_with_reset(fd);
+        if (!ok) co_return;
+        connections.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void bench_reactors(std::uint32_t reactors, const std::vector<scheduler_ptr> &clients) {
+    coro_ext::reactor_server::options opts;
+    opts.reactor_count = reactors;
+    coro_ext::reactor_server server{opts, echo_handler};
+    std::thread server_thread{[&server] { coro::sync_wait(server.run()); }};
+    const std::string suffix = ", " + std::to_string(reactors) + (reactors == 1 ? " reactor" : " reactors");
+    const std::string echo_name = "tcp echo: " + std::to_string(kEchoConnections) + " connections x " +
+                                  std::to_string(kEchoMessages) + " messages" + suffix;
+    const std::string connect_name = "tcp connection rate: " + std::to_string(kConnectClients * kConnectsPerClient) +
+                                     " connect/exchange/close" + suffix;
+
+    std::vector<int> fds(kEchoConnections, -1);
+    {
+        std::vector<coro::task<void>> tasks;
+        for (std::size_t i = 0; i < fds.size(); ++i) {
+            tasks.emplace_back(open_connection(clients[i % clients.size()], server.port(), fds[i]));
+        }
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+    }
+    const bool all_connected = std::all_of(fds.begin(), fds.end(), [](int fd) { return fd >= 0; });
+
+    std::atomic<std::uint64_t> round_trips{0};
+    if (all_connected) {
+        BENCHMARK(echo_name.c_str()) {
+            round_trips.store(0, std::memory_order_relaxed);
+            std::vector<coro::task<void>> tasks;
+            for (std::size_t i = 0; i < fds.size(); ++i) {
+                tasks.emplace_back(echo_client(clients[i % clients.size()], fds[i], round_trips));
+            }
+            coro::sync_wait(coro::when_all(std::move(tasks)));
+            return round_trips.load(std::memory_order_relaxed);
+        };
+    }
+    for (const int fd : fds) {
+        if (fd >= 0) ::close(fd);
+    }
+
+    std::atomic<std::uint64_t> connections{0};
+    BENCHMARK(connect_name.c_str()) {
+        connections.store(0, std::memory_order_relaxed);
+        std::vector<coro::task<void>> tasks;
+        for (std::size_t i = 0; i < kConnectClients; ++i) {
+            tasks.emplace_back(connect_client(clients[i % clients.size()], server.port(), connections));
+        }
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+        return connections.load(std::memory_order_relaxed);
+    };
+
+    std::cout << "[reactor_server] " << reactors << " reactor(s), connections accepted per reactor:";
+    for (std::size_t i = 0; i < server.reactor_count(); ++i) std::cout << ' ' << server.accepted(i);
+    std::cout << "\n";
+
+    server.shutdown();
+    server_thread.join();
+    REQUIRE(all_connected);
+    REQUIRE(round_trips.load() == kEchoConnections * kEchoMessages);
+    REQUIRE(connections.load() == kConnectClients * kConnectsPerClient);
+}
+
+} // namespace
+
+TEST_CASE("reactor_server echo and connection rate across reactors", "[bench][reactor_server]") {
+    const auto counts = bench_reactor_counts();
+    const auto clients = make_client_schedulers(counts.back());
+    for (const auto reactors : counts) bench_reactors(reactors, clients);
+}
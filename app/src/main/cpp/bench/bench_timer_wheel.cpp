@@ -0,0 +1,185 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/timer_wheel.hpp"
+
+#include <coro/coro.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Timer bookkeeping and wake-up accuracy, coro_ext::timer_wheel vs an ordered tree:
+//  - arm/cancel: kArmOps arms spread over kLiveTimers per-connection timeouts (so most arms re-arm a pending timer,
+//    like a read timeout pushed back on every read), then every timer is cancelled. The baseline is the
+//    std::multimap<time_point, ...> that coro::io_scheduler keeps its timed events in;
+//  - jitter: kSleepers coroutines each sleep kSleepsPerSleeper times for 1-10 ms on one io_scheduler, through
+//    io_scheduler::yield_for() and through timer_wheel::sleep_for(); lateness against the requested deadline is
+//    reported as mean/p50/p99/max.
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t kArmOps = 1'000'000;
+constexpr std::size_t kLiveTimers = 100'000;
+constexpr std::size_t kSleepers = 100;
+constexpr std::size_t kSleepsPerSleeper = 20;
+
+std::vector<std::chrono::milliseconds> random_timeouts(std::size_t count, int min_ms, int max_ms) {
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> dist{min_ms, max_ms};
+    std::vector<std::chrono::milliseconds> timeouts(count);
+    for (auto &t : timeouts) t = std::chrono::milliseconds{dist(rng)};
+    return timeouts;
+}
+
+// Ordered-tree baseline: each connection remembers its position so it can be erased on re-arm/cancel.
+struct tree_timers {
+    struct entry {
+        std::multimap<clock_type::time_point, entry *>::iterator position;
+        bool armed = false;
+    };
+
+    std::multimap<clock_type::time_point, entry *> tree;
+
+    void arm(entry &e, std::chrono::nanoseconds timeout) {
+        if (e.armed) tree.erase(e.position);
+        e.position = tree.emplace(clock_type::now() + timeout, &e);
+        e.armed = true;
+    }
+
+    void cancel(entry &e) {
+        if (!e.armed) return;
+        tree.erase(e.position);
+        e.armed = false;
+    }
+};
+
+std::size_t arm_and_cancel_tree(const std::vector<std::chrono::milliseconds> &timeouts) {
+    tree_timers timers;
+    std::vector<tree_timers::entry> entries(kLiveTimers);
+    for (std::size_t i = 0; i < timeouts.size(); ++i) timers.arm(entries[i % kLiveTimers], timeouts[i]);
+    const std::size_t peak = timers.tree.size();
+    for (auto &e : entries) timers.cancel(e);
+    return peak;
+}
+
+std::size_t arm_and_cancel_wheel(const std::vector<std::chrono::milliseconds> &timeouts) {
+    coro_ext::timer_wheel wheel;
+    std::vector<coro_ext::timer_wheel::timer> timers(kLiveTimers);
+    for (std::size_t i = 0; i < timeouts.size(); ++i) wheel.arm(timers[i % kLiveTimers], timeouts[i]);
+    const std::size_t peak = wheel.size();
+    for (auto &t : timers) t.cancel();
+    return peak;
+}
+
+struct lateness_stats {
+    std::vector<double> samples_us;
+
+    void report(const std::string &label) {
+        std::sort(samples_us.begin(), samples_us.end());
+        double sum = 0;
+        for (double v : samples_us) sum += v;
+        const auto at = [&](double q) {
+            return samples_us[std::min(samples_us.size() - 1, static_cast<std::size_t>(q * samples_us.size()))];
+        };
+        std::cout << "[timer_wheel] " << label << ": " << samples_us.size() << " sleeps, lateness mean "
+                  << sum / samples_us.size() << " us, p50 " << at(0.5) << " us, p99 " << at(0.99) << " us, max "
+                  << samples_us.back() << " us\n";
+    }
+};
+
+double lateness_us(clock_type::time_point start, std::chrono::milliseconds requested) {
+    return std::chrono::duration<double, std::micro>(clock_type::now() - (start + requested)).count();
+}
+
+coro::task<void> scheduler_sleeper(std::shared_ptr<coro::io_scheduler> scheduler,
+                                   std::vector<std::chrono::milliseconds> sleeps, lateness_stats &stats) {
+    co_await scheduler->schedule();
+    for (const auto d : sleeps) {
+        const auto start = clock_type::now();
+        co_await scheduler->yield_for(d);
+        stats.samples_us.push_back(lateness_us(start, d));
+    }
+    co_return;
+}
+
+coro::task<void> wheel_sleeper(std::shared_ptr<coro::io_scheduler> scheduler, coro_ext::timer_wheel &wheel,
+                               std::vector<std::chrono::milliseconds> sleeps, lateness_stats &stats,
+                               std::size_t &running) {
+    co_await scheduler->schedule();
+    for (const auto d : sleeps) {
+        const auto start = clock_type::now();
+        co_await wheel.sleep_for(d);
+        stats.samples_us.push_back(lateness_us(start, d));
+    }
+    // Everything runs on the io thread, so a plain counter is enough.
+    if (--running == 0) wheel.shutdown();
+    co_return;
+}
+
+std::vector<std::chrono::milliseconds> sleeps_for(std::size_t sleeper) {
+    auto all = random_timeouts(kSleepers * kSleepsPerSleeper, 1, 10);
+    return {all.begin() + static_cast<std::ptrdiff_t>(sleeper * kSleepsPerSleeper),
+            all.begin() + static_cast<std::ptrdiff_t>((sleeper + 1) * kSleepsPerSleeper)};
+}
+
+std::shared_ptr<coro::io_scheduler> make_inline_scheduler() {
+    return coro::io_scheduler::make_shared(coro::io_scheduler::options{
+        .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+}
+
+} // namespace
+
+TEST_CASE("timer_wheel arm/cancel vs ordered tree", "[bench][timer_wheel]") {
+    const auto timeouts = random_timeouts(kArmOps, 1'000, 30'000);
+    const std::string suffix = ": " + std::to_string(kArmOps) + " arms over " + std::to_string(kLiveTimers) +
+                               " timers, then cancel all";
+    std::size_t peak = 0;
+    BENCHMARK(("timers, ordered tree (std::multimap)" + suffix).c_str()) {
+        peak = arm_and_cancel_tree(timeouts);
+        return peak;
+    };
+    REQUIRE(peak == kLiveTimers);
+    BENCHMARK(("timers, timer_wheel" + suffix).c_str()) {
+        peak = arm_and_cancel_wheel(timeouts);
+        return peak;
+    };
+    REQUIRE(peak == kLiveTimers);
+}
+
+TEST_CASE("timer_wheel wake-up jitter vs io_scheduler", "[bench][timer_wheel]") {
+    {
+        auto scheduler = make_inline_scheduler();
+        lateness_stats stats;
+        std::vector<coro::task<void>> tasks;
+        for (std::size_t i = 0; i < kSleepers; ++i) {
+            tasks.emplace_back(scheduler_sleeper(scheduler, sleeps_for(i), stats));
+        }
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+        REQUIRE(stats.samples_us.size() == kSleepers * kSleepsPerSleeper);
+        stats.report("io_scheduler::yield_for");
+    }
+    for (const auto tick : {std::chrono::microseconds{1000}, std::chrono::microseconds{100}}) {
+        auto scheduler = make_inline_scheduler();
+        coro_ext::timer_wheel wheel{coro_ext::timer_wheel::options{.tick = tick}};
+        lateness_stats stats;
+        std::size_t running = kSleepers;
+        std::vector<coro::task<void>> tasks;
+        tasks.emplace_back(wheel.run(scheduler));
+        for (std::size_t i = 0; i < kSleepers; ++i) {
+            tasks.emplace_back(wheel_sleeper(scheduler, wheel, sleeps_for(i), stats, running));
+        }
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+        REQUIRE(stats.samples_us.size() == kSleepers * kSleepsPerSleeper);
+        stats.report("timer_wheel::sleep_for, tick " + std::to_string(tick.count()) + " us");
+    }
+}
@@ -0,0 +1,105 @@
+// All code comments are in English per repo policy.
+
+#ifdef LIBCORO_FEATURE_TLS
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/record_buffer_pool.hpp"
+#include "coro_ext/tls_session_cache.hpp"
+#include "test/tls_loopback.hpp"
+
+#include <coro/coro.hpp>
+#include <openssl/ssl.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Loopback TLS connections through net::tls::client and net::tls::server, set up like libcoro's test_tls_server.cpp:
+// the server context loads cert.pem/key.pem from the working directory (the test runners generate them) and the
+// client context does not verify the peer. Server and client each run on their own io_scheduler. Every connection
+// connects, requests a response of a given size, reads it and closes; both sides read and write through buffers
+// leased from one coro_ext::record_buffer_pool. Each run is measured with session resumption off (full handshake per
+// connection) and on (coro_ext::tls_session_cache attached to the client context; the clients do nothing
+// cache-specific). The server's SSL_CTX statistics confirm how many handshakes were resumed.
+//  - handshakes: a 1-byte response, so the client also reads the TLS 1.3 tickets sent after the handshake;
+//  - short connections: handshake + a 64 KiB response.
+
+namespace {
+
+// Distinct from the 8080 default that test_tls_server.cpp listens on.
+constexpr std::uint16_t kPort = 8443;
+constexpr std::uint32_t kHandshakeResponse = 1;
+constexpr std::uint32_t kTransferBytes = 64 * 1024;
+
+using scheduler_ptr = std::shared_ptr<coro::io_scheduler>;
+
+scheduler_ptr make_inline_scheduler() {
+    return coro::io_scheduler::make_shared(coro::io_scheduler::options{
+        .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+}
+
+void bench_connections(const std::string &name, bool resumption, std::uint32_t response_size) {
+    coro_ext::record_buffer_pool buffers;
+    coro_ext::tls_session_cache cache;
+    // No client certificates: a server that requests them also needs a session id context to resume sessions.
+    auto server_ctx = std::make_shared<coro::net::tls::context>("cert.pem", coro::net::tls::tls_file_type::pem,
+                                                                "key.pem", coro::net::tls::tls_file_type::pem,
+                                                                coro::net::tls::verify_peer_t::no);
+    auto client_ctx = std::make_shared<coro::net::tls::context>(coro::net::tls::verify_peer_t::no);
+    if (resumption) cache.attach(*client_ctx);
+
+    auto server_scheduler = make_inline_scheduler();
+    auto client_scheduler = make_inline_scheduler();
+    coro::net::tls::server server{server_scheduler, server_ctx, coro::net::tls::server::options{.port = kPort}};
+    std::atomic<bool> stop{false};
+    std::thread server_thread{
+        [&] { coro::sync_wait(tls_loopback::net_serve(server_scheduler, server, buffers, stop)); }};
+    const auto request = [&](std::uint32_t size) {
+        return coro::sync_wait(tls_loopback::net_request(client_scheduler, client_ctx, kPort, size, buffers));
+    };
+
+    // Warm-up connection so the resumption run starts with a cached session.
+    const bool warmed_up = request(response_size) == response_size;
+    SSL_CTX *server_ssl_ctx = coro_ext::native_handle(*server_ctx);
+    const long resumed_before = SSL_CTX_sess_hits(server_ssl_ctx);
+
+    std::uint64_t failures = 0;
+    std::uint64_t total = 0;
+    if (warmed_up) {
+        BENCHMARK(name.c_str()) {
+            const std::int64_t received = request(response_size);
+            failures += received == response_size ? 0 : 1;
+            ++total;
+            return received;
+        };
+    }
+    const long resumed = SSL_CTX_sess_hits(server_ssl_ctx) - resumed_before;
+    tls_loopback::net_stop(stop, kPort);
+    server_thread.join();
+
+    REQUIRE(warmed_up);
+    REQUIRE(failures == 0);
+    if (resumption) {
+        REQUIRE(resumed == static_cast<long>(total));
+    } else {
+        REQUIRE(resumed == 0);
+    }
+}
+
+} // namespace
+
+TEST_CASE("tls_session_cache handshakes with and without resumption", "[bench][tls_session_cache]") {
+    bench_connections("TLS handshake, resumption off", false, kHandshakeResponse);
+    bench_connections("TLS handshake, resumption on", true, kHandshakeResponse);
+}
+
+TEST_CASE("tls_session_cache short connections with and without resumption", "[bench][tls_session_cache]") {
+    const std::string suffix = ", handshake + " + std::to_string(kTransferBytes / 1024) + " KiB";
+    bench_connections("TLS connection, resumption off" + suffix, false, kTransferBytes);
+    bench_connections("TLS connection, resumption on" + suffix, true, kTransferBytes);
+}
+
+#endif // LIBCORO_FEATURE_TLS
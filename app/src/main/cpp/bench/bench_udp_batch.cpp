@@ -0,0 +1,201 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/udp_batch.hpp"
+
+#include <coro/coro.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// UDP loopback packets/sec between two connected sockets on one coro::io_scheduler (process_tasks_inline). The sender
+// keeps kWindow datagrams in flight and waits for a 1-byte ack from the receiver after each window, so the receive
+// buffer never overflows and every run delivers exactly kPackets packets.
+//  - single: one send() per datagram, poll() + recv() per datagram on the receiver (the coro::net::udp::peer pattern);
+//  - batched: coro_ext::udp_batch, one sendmmsg per window and one poll() + recvmmsg per burst on the receiver;
+//  - GSO/GRO (when supported): each window goes out as one kWindow-segment GSO send and usually arrives coalesced.
+
+namespace {
+
+constexpr std::size_t kPacketSize = 256;
+constexpr std::size_t kWindow = 64;
+constexpr std::size_t kWindows = 200;
+constexpr std::size_t kPackets = kWindow * kWindows;
+constexpr std::size_t kDatagramBufferSize = 2048;
+// Large enough for a coalesced GRO datagram carrying a whole window.
+constexpr std::size_t kCoalescedBufferSize = 64 * 1024;
+constexpr std::size_t kCoalescedSlots = 8;
+
+using scheduler_ptr = std::shared_ptr<coro::io_scheduler>;
+
+struct udp_pair {
+    int sender = -1;
+    int receiver = -1;
+
+    udp_pair() {
+        sender = open_bound();
+        receiver = open_bound();
+        if (sender < 0 || receiver < 0 || !connect_to(sender, receiver) || !connect_to(receiver, sender)) close_all();
+    }
+
+    udp_pair(const udp_pair &) = delete;
+    udp_pair &operator=(const udp_pair &) = delete;
+    ~udp_pair() { close_all(); }
+
+    bool valid() const { return sender >= 0 && receiver >= 0; }
+
+private:
+    static int open_bound() {
+        const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+        if (fd < 0) return -1;
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        const int buffer = 1 << 20;
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+        if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    static bool connect_to(int fd, int peer) {
+        sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        return ::getsockname(peer, reinterpret_cast<sockaddr *>(&addr), &len) == 0 &&
+               ::connect(fd, reinterpret_cast<sockaddr *>(&addr), len) == 0;
+    }
+
+    void close_all() {
+        if (sender >= 0) ::close(sender);
+        if (receiver >= 0) ::close(receiver);
+        sender = receiver = -1;
+    }
+};
+
+enum class mode { single, batched, offload };
+
+// Packets carried by a received datagram: a GRO-coalesced datagram holds several segment_size-byte packets.
+std::size_t packets_in(const coro_ext::udp_batch::datagram &d) {
+    return d.segment_size == 0 ? 1 : (d.size + d.segment_size - 1) / d.segment_size;
+}
+
+coro::task<bool> wait_ack(scheduler_ptr scheduler, int fd) {
+    char ack = 0;
+    for (;;) {
+        if (::recv(fd, &ack, sizeof(ack), 0) == 1) co_return true;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) co_return false;
+        if (co_await scheduler->poll(fd, coro::poll_op::read) != coro::poll_status::event) co_return false;
+    }
+}
+
+coro::task<void> sender(scheduler_ptr scheduler, int fd, mode kind) {
+    co_await scheduler->schedule();
+    std::vector<char> payload(kWindow * kPacketSize, 'x');
+    coro_ext::udp_batch batch{coro_ext::udp_batch::options{.max_batch = kWindow}};
+    std::vector<coro_ext::udp_batch::datagram> window;
+    if (kind == mode::batched) {
+        window.resize(kWindow);
+        for (std::size_t i = 0; i < kWindow; ++i) window[i].data = {payload.data() + i * kPacketSize, kPacketSize};
+    } else if (kind == mode::offload) {
+        window.resize(1);
+        window[0].data = {payload.data(), payload.size()};
+        window[0].segment_size = kPacketSize;
+    }
+
+    for (std::size_t w = 0; w < kWindows; ++w) {
+        if (kind == mode::single) {
+            for (std::size_t i = 0; i < kWindow;) {
+                if (::send(fd, payload.data(), kPacketSize, 0) == static_cast<ssize_t>(kPacketSize)) {
+                    ++i;
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    co_return;
+                } else {
+                    (void)co_await scheduler->poll(fd, coro::poll_op::write);
+                }
+            }
+        } else {
+            for (std::size_t sent = 0; sent < window.size();) {
+                const int n = batch.send(fd, std::span{window}.subspan(sent));
+                if (n < 0) co_return;
+                if (n == 0) (void)co_await scheduler->poll(fd, coro::poll_op::write);
+                sent += static_cast<std::size_t>(n);
+            }
+        }
+        if (!co_await wait_ack(scheduler, fd)) co_return;
+    }
+}
+
+coro::task<void> receiver(scheduler_ptr scheduler, int fd, mode kind, std::atomic<std::uint64_t> &packets) {
+    co_await scheduler->schedule();
+    coro_ext::udp_batch batch{coro_ext::udp_batch::options{.max_batch = kWindow}};
+    const std::size_t slots = kind == mode::single ? 1 : kind == mode::batched ? kWindow : kCoalescedSlots;
+    const std::size_t slot_size = kind == mode::offload ? kCoalescedBufferSize : kDatagramBufferSize;
+    std::vector<char> storage(slots * slot_size);
+    std::vector<coro_ext::udp_batch::datagram> window(slots);
+    for (std::size_t i = 0; i < slots; ++i) window[i].data = {storage.data() + i * slot_size, slot_size};
+
+    for (std::size_t w = 0; w < kWindows; ++w) {
+        std::size_t received = 0;
+        while (received < kWindow) {
+            if (co_await scheduler->poll(fd, coro::poll_op::read) != coro::poll_status::event) co_return;
+            if (kind == mode::single) {
+                if (::recv(fd, storage.data(), storage.size(), 0) > 0) ++received;
+                continue;
+            }
+            // Drain everything that is queued before polling again.
+            for (;;) {
+                const int n = batch.recv(fd, window);
+                if (n <= 0) break;
+                for (int i = 0; i < n; ++i) received += packets_in(window[i]);
+            }
+        }
+        packets.fetch_add(received, std::memory_order_relaxed);
+        const char ack = 1;
+        if (::send(fd, &ack, sizeof(ack), 0) != 1) co_return;
+    }
+}
+
+void bench_mode(mode kind, const std::string &name) {
+    udp_pair pair;
+    REQUIRE(pair.valid());
+    if (kind == mode::offload) REQUIRE(coro_ext::udp_batch::enable_gro(pair.receiver));
+    auto scheduler = coro::io_scheduler::make_shared(coro::io_scheduler::options{
+        .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+    std::atomic<std::uint64_t> packets{0};
+    BENCHMARK(name.c_str()) {
+        packets.store(0, std::memory_order_relaxed);
+        std::vector<coro::task<void>> tasks;
+        tasks.emplace_back(receiver(scheduler, pair.receiver, kind, packets));
+        tasks.emplace_back(sender(scheduler, pair.sender, kind));
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+        return packets.load(std::memory_order_relaxed);
+    };
+    REQUIRE(packets.load() == kPackets);
+}
+
+const std::string kSuffix = ": " + std::to_string(kPackets) + " x " + std::to_string(kPacketSize) + " B";
+
+} // namespace
+
+TEST_CASE("udp_batch loopback packets/sec", "[bench][udp_batch]") {
+    bench_mode(mode::single, "udp loopback, send/recv per datagram" + kSuffix);
+    bench_mode(mode::batched, "udp loopback, sendmmsg/recvmmsg batch " + std::to_string(kWindow) + kSuffix);
+    if (!coro_ext::udp_batch::gso_supported()) {
+        WARN("UDP GSO is not available on this system; skipping the offload run");
+        return;
+    }
+    bench_mode(mode::offload, "udp loopback, GSO/GRO " + std::to_string(kWindow) + " segments" + kSuffix);
+}
@@ -0,0 +1,224 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/uring_scheduler.hpp"
+
+#include <coro/coro.hpp>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// TCP loopback echo: kConnections client/server socket pairs, each client sends kMessages fixed-size messages and
+// waits for the echo before sending the next. Both sides run as coroutines on a single io thread.
+//  - epoll: coro::io_scheduler (process_tasks_inline), poll() then read()/write() as in the libcoro samples;
+//  - io_uring: coro_ext::uring_scheduler, read/write submitted directly and batched per loop iteration.
+
+namespace {
+
+constexpr std::size_t kConnections = 16;
+constexpr std::size_t kMessages = 500;
+constexpr std::size_t kMessageSize = 64;
+
+struct loopback_pairs {
+    std::vector<int> clients;
+    std::vector<int> servers;
+
+    explicit loopback_pairs(std::size_t count) {
+        const int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listener, static_cast<int>(count)) != 0 ||
+            ::getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &len) != 0) {
+            if (listener >= 0) ::close(listener);
+            return;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            const int client = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (client < 0 || ::connect(client, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+                if (client >= 0) ::close(client);
+                break;
+            }
+            const int server = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (server < 0) {
+                ::close(client);
+                break;
+            }
+            clients.push_back(configure(client));
+            servers.push_back(configure(server));
+        }
+        ::close(listener);
+    }
+
+    loopback_pairs(const loopback_pairs &) = delete;
+    loopback_pairs &operator=(const loopback_pairs &) = delete;
+
+    ~loopback_pairs() {
+        for (int fd : clients) ::close(fd);
+        for (int fd : servers) ::close(fd);
+    }
+
+    static int configure(int fd) {
+        const int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        return fd;
+    }
+};
+
+// --- epoll (coro::io_scheduler) ---
+
+coro::task<bool> epoll_write_all(std::shared_ptr<coro::io_scheduler> scheduler, int fd, const char *data,
+                                 std::size_t size) {
+    while (size > 0) {
+        const ssize_t n = ::write(fd, data, size);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (co_await scheduler->poll(fd, coro::poll_op::write) != coro::poll_status::event) co_return false;
+            continue;
+        }
+        if (n <= 0) co_return false;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    co_return true;
+}
+
+coro::task<void> epoll_echo_server(std::shared_ptr<coro::io_scheduler> scheduler, int fd, std::size_t total) {
+    co_await scheduler->schedule();
+    std::array<char, kMessageSize> buffer{};
+    std::size_t echoed = 0;
+    while (echoed < total) {
+        if (co_await scheduler->poll(fd, coro::poll_op::read) != coro::poll_status::event) co_return;
+        const ssize_t n = ::read(fd, buffer.data(), buffer.size());
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+        if (n <= 0) co_return;
+        if (!co_await epoll_write_all(scheduler, fd, buffer.data(), static_cast<std::size_t>(n))) co_return;
+        echoed += static_cast<std::size_t>(n);
+    }
+}
+
+coro::task<void> epoll_echo_client(std::shared_ptr<coro::io_scheduler> scheduler, int fd, std::size_t messages,
+                                   std::atomic<std::uint64_t> &round_trips) {
+    co_await scheduler->schedule();
+    std::array<char, kMessageSize> out{};
+    std::array<char, kMessageSize> in{};
+    for (std::size_t i = 0; i < messages; ++i) {
+        out.fill(static_cast<char>(i));
+        if (!co_await epoll_write_all(scheduler, fd, out.data(), out.size())) co_return;
+        std::size_t received = 0;
+        while (received < in.size()) {
+            if (co_await scheduler->poll(fd, coro::poll_op::read) != coro::poll_status::event) co_return;
+            const ssize_t n = ::read(fd, in.data() + received, in.size() - received);
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+            if (n <= 0) co_return;
+            received += static_cast<std::size_t>(n);
+        }
+        if (in != out) co_return;
+        round_trips.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// --- io_uring (coro_ext::uring_scheduler) ---
+
+coro::task<bool> uring_write_all(coro_ext::uring_scheduler &scheduler, int fd, const char *data, std::size_t size) {
+    while (size > 0) {
+        const int n = co_await scheduler.write(fd, std::span<const char>{data, size});
+        if (n <= 0) co_return false;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    co_return true;
+}
+
+coro::task<void> uring_echo_server(coro_ext::uring_scheduler &scheduler, int fd, std::size_t total) {
+    co_await scheduler.schedule();
+    std::array<char, kMessageSize> buffer{};
+    std::size_t echoed = 0;
+    while (echoed < total) {
+        const int n = co_await scheduler.read(fd, buffer);
+        if (n <= 0) co_return;
+        if (!co_await uring_write_all(scheduler, fd, buffer.data(), static_cast<std::size_t>(n))) co_return;
+        echoed += static_cast<std::size_t>(n);
+    }
+}
+
+coro::task<void> uring_echo_client(coro_ext::uring_scheduler &scheduler, int fd, std::size_t messages,
+                                   std::atomic<std::uint64_t> &round_trips) {
+    co_await scheduler.schedule();
+    std::array<char, kMessageSize> out{};
+    std::array<char, kMessageSize> in{};
+    for (std::size_t i = 0; i < messages; ++i) {
+        out.fill(static_cast<char>(i));
+        if (!co_await uring_write_all(scheduler, fd, out.data(), out.size())) co_return;
+        std::size_t received = 0;
+        while (received < in.size()) {
+            const int n = co_await scheduler.read(fd, std::span<char>{in.data() + received, in.size() - received});
+            if (n <= 0) co_return;
+            received += static_cast<std::size_t>(n);
+        }
+        if (in != out) co_return;
+        round_trips.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+const std::string kEchoSuffix = " " + std::to_string(kConnections) + " connections x " + std::to_string(kMessages) +
+                                " x " + std::to_string(kMessageSize) + " B";
+
+} // namespace
+
+TEST_CASE("uring_scheduler tcp echo vs io_scheduler", "[bench][uring_scheduler]") {
+    // Connections are set up once and reused: every iteration drains them completely.
+    loopback_pairs pairs{kConnections};
+    REQUIRE(pairs.clients.size() == kConnections);
+    const std::uint64_t expected = kConnections * kMessages;
+    std::atomic<std::uint64_t> round_trips{0};
+
+    {
+        auto scheduler = coro::io_scheduler::make_shared(coro::io_scheduler::options{
+            .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+        BENCHMARK(("io_scheduler (epoll) echo" + kEchoSuffix).c_str()) {
+            round_trips.store(0, std::memory_order_relaxed);
+            std::vector<coro::task<void>> tasks;
+            for (std::size_t i = 0; i < pairs.clients.size(); ++i) {
+                tasks.emplace_back(epoll_echo_server(scheduler, pairs.servers[i], kMessages * kMessageSize));
+                tasks.emplace_back(epoll_echo_client(scheduler, pairs.clients[i], kMessages, round_trips));
+            }
+            coro::sync_wait(coro::when_all(std::move(tasks)));
+            return round_trips.load(std::memory_order_relaxed);
+        };
+        REQUIRE(round_trips.load() == expected);
+    }
+
+    if (!coro_ext::uring_scheduler::is_supported()) {
+        WARN("io_uring is not available on this system; skipping the uring_scheduler run");
+        return;
+    }
+    {
+        coro_ext::uring_scheduler scheduler{coro_ext::uring_scheduler::options{.entries = 256}};
+        BENCHMARK(("uring_scheduler (io_uring) echo" + kEchoSuffix).c_str()) {
+            round_trips.store(0, std::memory_order_relaxed);
+            std::vector<coro::task<void>> tasks;
+            for (std::size_t i = 0; i < pairs.clients.size(); ++i) {
+                tasks.emplace_back(uring_echo_server(scheduler, pairs.servers[i], kMessages * kMessageSize));
+                tasks.emplace_back(uring_echo_client(scheduler, pairs.clients[i], kMessages, round_trips));
+            }
+            coro::sync_wait(coro::when_all(std::move(tasks)));
+            return round_trips.load(std::memory_order_relaxed);
+        };
+        REQUIRE(round_trips.load() == expected);
+    }
+}
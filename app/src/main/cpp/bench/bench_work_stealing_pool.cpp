@@ -0,0 +1,110 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/work_stealing_pool.hpp"
+
+#include <coro/coro.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// coro::thread_pool (single shared FIFO) vs coro_ext::work_stealing_pool on the same workloads:
+//  - fan-out: one task spawns many leaves from inside the pool, so they land on the spawning worker's deque and
+//    the other workers have to steal them;
+//  - hop chain: one task reschedules itself repeatedly (pure schedule() overhead, no parallelism).
+
+namespace {
+
+constexpr std::size_t kFanOutLeaves = 10'000;
+constexpr std::size_t kHopCount = 10'000;
+
+std::vector<std::uint32_t> bench_thread_counts() {
+    std::vector<std::uint32_t> counts{1, 2, 4, 8};
+    const std::uint32_t hw = std::thread::hardware_concurrency();
+    if (hw > 8) counts.push_back(hw);
+    return counts;
+}
+
+template <typename pool_type>
+coro::task<void> fan_out_leaf(pool_type &pool, std::atomic<std::uint64_t> &counter) {
+    co_await pool.schedule();
+    counter.fetch_add(1, std::memory_order_relaxed);
+    co_return;
+}
+
+template <typename pool_type>
+coro::task<void> fan_out_root(pool_type &pool, std::atomic<std::uint64_t> &counter, std::size_t leaves) {
+    co_await pool.schedule();
+    std::vector<coro::task<void>> tasks;
+    tasks.reserve(leaves);
+    for (std::size_t i = 0; i < leaves; ++i) tasks.emplace_back(fan_out_leaf(pool, counter));
+    co_await coro::when_all(std::move(tasks));
+    co_return;
+}
+
+template <typename pool_type>
+coro::task<std::uint64_t> hop_chain(pool_type &pool, std::size_t hops) {
+    co_await pool.schedule();
+    std::uint64_t done = 0;
+    for (std::size_t i = 0; i < hops; ++i) {
+        co_await pool.schedule();
+        ++done;
+    }
+    co_return done;
+}
+
+template <typename pool_type>
+void bench_fan_out(pool_type &pool, const std::string &name) {
+    std::atomic<std::uint64_t> counter{0};
+    BENCHMARK(name.c_str()) {
+        counter.store(0, std::memory_order_relaxed);
+        coro::sync_wait(fan_out_root(pool, counter, kFanOutLeaves));
+        return counter.load(std::memory_order_relaxed);
+    };
+    REQUIRE(counter.load() == kFanOutLeaves);
+}
+
+template <typename pool_type>
+void bench_hop_chain(pool_type &pool, const std::string &name) {
+    std::uint64_t hops = 0;
+    BENCHMARK(name.c_str()) {
+        hops = coro::sync_wait(hop_chain(pool, kHopCount));
+        return hops;
+    };
+    REQUIRE(hops == kHopCount);
+}
+
+} // namespace
+
+TEST_CASE("work_stealing_pool fan-out vs thread_pool", "[bench][work_stealing_pool]") {
+    for (const auto threads : bench_thread_counts()) {
+        const std::string suffix = " " + std::to_string(kFanOutLeaves) + " leaves, " + std::to_string(threads) +
+                                   " threads";
+        {
+            coro::thread_pool tp{coro::thread_pool::options{.thread_count = threads}};
+            bench_fan_out(tp, "thread_pool fan-out" + suffix);
+        }
+        {
+            coro_ext::work_stealing_pool wsp{coro_ext::work_stealing_pool::options{.thread_count = threads}};
+            bench_fan_out(wsp, "work_stealing_pool fan-out" + suffix);
+        }
+    }
+}
+
+TEST_CASE("work_stealing_pool schedule hop chain vs thread_pool", "[bench][work_stealing_pool]") {
+    for (const auto threads : bench_thread_counts()) {
+        const std::string suffix = " " + std::to_string(kHopCount) + " hops, " + std::to_string(threads) + " threads";
+        {
+            coro::thread_pool tp{coro::thread_pool::options{.thread_count = threads}};
+            bench_hop_chain(tp, "thread_pool hop chain" + suffix);
+        }
+        {
+            coro_ext::work_stealing_pool wsp{coro_ext::work_stealing_pool::options{.thread_count = threads}};
+            bench_hop_chain(wsp, "work_stealing_pool hop chain" + suffix);
+        }
+    }
+}
@@ -0,0 +1,221 @@
+// All code comments are in English per repo policy.
+//
+// Host (Linux) benchmark runner for the libcoro test sources.
+// Runs the [bench] test cases with Catch2's full statistical analysis and writes one JSON record per benchmark
+// (ops/sec, mean latency, p50/p99 of the per-sample means, allocations per op). Compare two result files with
+// scripts/bench_compare.py.
+
+#include "catch_amalgamated.hpp"
+#include "alloc_counter.hpp"
+
+#include <algorithm>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BenchResult {
+    std::string test_case;
+    std::string name;
+    std::uint64_t samples = 0;
+    std::uint64_t iterations = 0;
+    double mean_ns = 0.0;
+    double stddev_ns = 0.0;
+    // Percentiles over the per-sample means (each sample averages `iterations` runs), not per-operation latency.
+    double sample_p50_ns = 0.0;
+    double sample_p99_ns = 0.0;
+    double ops_per_sec = 0.0;
+    // Raw heap allocations between benchmarkStarting and benchmarkEnded; see kCalibrationTestCase.
+    std::uint64_t allocations = 0;
+};
+
+std::vector<BenchResult> g_results;
+
+// The allocation window of a benchmark ends at benchmarkEnded, after Catch's bootstrap analysis, which allocates on
+// every resample. This allocation-free benchmark measures that overhead (same sample and resample counts) so it can
+// be subtracted from every other benchmark before dividing by the number of operations.
+constexpr const char *kCalibrationTestCase = "bench_main allocation calibration";
+constexpr const char *kCalibrationSpec = "[bench_calibration]";
+
+// Nearest-rank percentile over an ascending sorted sample set.
+double percentile(const std::vector<double> &sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    auto rank = static_cast<std::size_t>(p / 100.0 * static_cast<double>(sorted.size()) + 0.5);
+    rank = std::clamp<std::size_t>(rank, 1, sorted.size());
+    return sorted[rank - 1];
+}
+
+// Collects per-benchmark statistics. Catch2 reports samples already normalized to a single iteration (ns/op).
+class BenchJsonListener : public Catch::EventListenerBase {
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void testCaseStarting(const Catch::TestCaseInfo &info) override {
+        test_case_ = info.name;
+    }
+
+    void benchmarkStarting(const Catch::BenchmarkInfo &info) override {
+        allocs_at_start_ = alloc_counter::allocations();
+        iterations_ = static_cast<std::uint64_t>(info.iterations);
+    }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<> &stats) override {
+        const auto allocs = alloc_counter::allocations() - allocs_at_start_;
+
+        std::vector<double> sorted;
+        sorted.reserve(stats.samples.size());
+        for (const auto &s : stats.samples) {
+            sorted.push_back(s.count());
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        BenchResult r;
+        r.test_case = test_case_;
+        r.name = stats.info.name;
+        r.samples = sorted.size();
+        r.iterations = iterations_;
+        r.mean_ns = stats.mean.point.count();
+        r.stddev_ns = stats.standardDeviation.point.count();
+        r.sample_p50_ns = percentile(sorted, 50.0);
+        r.sample_p99_ns = percentile(sorted, 99.0);
+        r.ops_per_sec = r.mean_ns > 0.0 ? 1e9 / r.mean_ns : 0.0;
+        r.allocations = allocs;
+        g_results.push_back(std::move(r));
+    }
+
+private:
+    std::string test_case_;
+    std::uint64_t allocs_at_start_ = 0;
+    std::uint64_t iterations_ = 0;
+};
+
+CATCH_REGISTER_LISTENER(BenchJsonListener)
+
+std::string json_escape(const std::string &s) {
+    std::string out;
+    out.reserve(s.size() + 2);
+    for (char c : s) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+bool write_json(const std::string &path) {
+    std::uint64_t analysis_allocations = 0;
+    for (const auto &r : g_results) {
+        if (r.test_case == kCalibrationTestCase) analysis_allocations = r.allocations;
+    }
+    std::ofstream ofs(path, std::ios::trunc);
+    if (!ofs.is_open()) return false;
+    ofs.precision(17);
+    ofs << "{\n  \"schema\": 2,\n  \"benchmarks\": [";
+    bool first = true;
+    for (const auto &r : g_results) {
+        if (r.test_case == kCalibrationTestCase) continue;
+        const auto ops = r.samples * r.iterations;
+        const auto allocs = r.allocations > analysis_allocations ? r.allocations - analysis_allocations : 0;
+        const double allocs_per_op = ops > 0 ? static_cast<double>(allocs) / static_cast<double>(ops) : 0.0;
+        ofs << (first ? "\n" : ",\n");
+        first = false;
+        ofs << "    {\"test_case\": \"" << json_escape(r.test_case) << "\", \"name\": \"" << json_escape(r.name)
+            << "\", \"samples\": " << r.samples << ", \"iterations\": " << r.iterations
+            << ", \"mean_ns\": " << r.mean_ns << ", \"stddev_ns\": " << r.stddev_ns
+            << ", \"sample_p50_ns\": " << r.sample_p50_ns << ", \"sample_p99_ns\": " << r.sample_p99_ns
+            << ", \"ops_per_sec\": " << r.ops_per_sec << ", \"allocs_per_op\": " << allocs_per_op << "}";
+    }
+    ofs << "\n  ]\n}\n";
+    return static_cast<bool>(ofs);
+}
+
+// Mirror the libcoro test main: TLS benchmarks expect cert.pem/key.pem in the working directory.
+void ensure_tls_assets() {
+#ifdef LIBCORO_FEATURE_TLS
+    if (std::filesystem::exists("cert.pem") && std::filesystem::exists("key.pem")) return;
+    int rc = std::system(
+        "openssl req -x509 -newkey rsa:2048 -keyout key.pem -out cert.pem -sha256 -days 3650 -nodes "
+        "-subj '/CN=localhost' >/dev/null 2>&1");
+    if (rc != 0) std::cerr << "warning: failed to generate cert.pem/key.pem, TLS benchmarks may fail\n";
+#endif
+}
+
+void print_usage(const char *argv0) {
+    std::cout << "Usage: " << argv0 << " [--json <path>] [Catch2 options and test specs]\n"
+              << "  --json <path>  write benchmark results as JSON (default: coro-bench.json)\n"
+              << "Without test specs only [bench] test cases are run.\n";
+}
+
+} // namespace
+
+// Hidden (only run through kCalibrationSpec, which main() always adds); excluded from the JSON output.
+TEST_CASE(kCalibrationTestCase, "[.][bench_calibration]") {
+    std::uint64_t value = 0;
+    BENCHMARK("allocation-free no-op") {
+        return ++value;
+    };
+}
+
+int main(int argc, char *argv[]) {
+    std::string json_path = "coro-bench.json";
+    std::vector<const char *> catch_argv;
+    catch_argv.push_back(argv[0]);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            catch_argv.push_back(argv[i]);
+        }
+    }
+    if (catch_argv.size() == 1) catch_argv.push_back("[bench]");
+    // Separate test specs are OR-ed, so the calibration benchmark runs alongside whatever was selected.
+    catch_argv.push_back(kCalibrationSpec);
+
+    // Prevent SIGPIPE from killing the process during networking benchmarks
+    std::signal(SIGPIPE, SIG_IGN);
+    ensure_tls_assets();
+
+    Catch::Session session;
+    session.configData().benchmarkNoAnalysis = false;
+    session.configData().showDurations = Catch::ShowDurations::Always;
+    int rc = session.applyCommandLine(static_cast<int>(catch_argv.size()), catch_argv.data());
+    if (rc != 0) return rc;
+    rc = session.run();
+
+    if (!write_json(json_path)) {
+        std::cerr << "Failed to write benchmark results to " << json_path << "\n";
+        return rc != 0 ? rc : 1;
+    }
+    std::cout << "Wrote " << g_results.size() << " benchmark results to " << json_path << "\n";
+    return rc;
+}
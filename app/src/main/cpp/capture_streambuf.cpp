@@ -0,0 +1,107 @@
+// All code comments are in English per repo policy.
+
+#include "capture_streambuf.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+CaptureStreambuf::CaptureStreambuf(Sink sink, std::size_t chunk_size)
+    : sink_(std::move(sink)), chunk_size_(std::max<std::size_t>(chunk_size, 256)),
+      pool_(std::make_shared<ChunkPool>()) {
+    pool_->free.reserve(kMaxFreeChunks);
+    chunk_ = acquire_chunk();
+    // No put area: every write goes through xsputn/overflow so concurrent writers serialize on mutex_.
+    setp(nullptr, nullptr);
+}
+
+CaptureStreambuf::~CaptureStreambuf() {
+    drain();
+}
+
+// The deleter runs wherever the last reference is dropped (usually the log consumer thread). The reference count
+// orders every read of the chunk before it is handed out again.
+std::shared_ptr<char[]> CaptureStreambuf::acquire_chunk() {
+    std::unique_ptr<char[]> chunk;
+    {
+        std::lock_guard<std::mutex> lk(pool_->mutex);
+        if (!pool_->free.empty()) {
+            chunk = std::move(pool_->free.back());
+            pool_->free.pop_back();
+        }
+    }
+    if (!chunk) chunk.reset(new char[chunk_size_]);
+    return std::shared_ptr<char[]>(chunk.release(), [pool = pool_](char *p) {
+        std::unique_ptr<char[]> retired(p);
+        std::lock_guard<std::mutex> lk(pool->mutex);
+        if (pool->free.size() < kMaxFreeChunks) pool->free.push_back(std::move(retired));
+    });
+}
+
+void CaptureStreambuf::drain() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (used_ > published_) publish_locked(used_);
+}
+
+CaptureStreambuf::int_type CaptureStreambuf::overflow(int_type ch) {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+    const char c = traits_type::to_char_type(ch);
+    std::lock_guard<std::mutex> lk(mutex_);
+    append_locked(&c, 1);
+    return ch;
+}
+
+std::streamsize CaptureStreambuf::xsputn(const char *s, std::streamsize n) {
+    if (n <= 0) return 0;
+    std::lock_guard<std::mutex> lk(mutex_);
+    append_locked(s, static_cast<std::size_t>(n));
+    return n;
+}
+
+void CaptureStreambuf::append_locked(const char *s, std::size_t n) {
+    while (n > 0) {
+        if (used_ == chunk_size_) rotate_locked();
+        const std::size_t take = std::min(n, chunk_size_ - used_);
+        char *dst = chunk_.get() + used_;
+        std::memcpy(dst, s, take);
+        used_ += take;
+        s += take;
+        n -= take;
+        // Hand over every line completed by this piece of the write.
+        if (const void *nl = ::memrchr(dst, '\n', take)) {
+            publish_locked(static_cast<std::size_t>(static_cast<const char *>(nl) - chunk_.get()) + 1);
+        }
+    }
+}
+
+// Publishes [published_, end) where end is just past a newline, or used_ when forcing out a partial line. Empty
+// lines are dropped by handing over each run of non-empty lines separately.
+void CaptureStreambuf::publish_locked(std::size_t end) {
+    std::string_view rest(chunk_.get() + published_, end - published_);
+    published_ = end;
+    for (;;) {
+        rest.remove_prefix(std::min(rest.find_first_not_of('\n'), rest.size()));
+        if (rest.empty()) return;
+        const auto blank = rest.find("\n\n");
+        auto run = rest.substr(0, blank);
+        if (run.back() == '\n') run.remove_suffix(1);
+        sink_(chunk_, run);
+        if (blank == std::string_view::npos) return;
+        rest.remove_prefix(blank + 1);
+    }
+}
+
+// Chunk is full. Complete lines are already published, so only a partial line can remain: carry it over to a fresh
+// chunk, unless it fills the whole chunk (high-water mark), in which case it is published as a line of its own.
+void CaptureStreambuf::rotate_locked() {
+    const std::size_t tail = used_ - published_;
+    if (tail == chunk_size_) {
+        publish_locked(used_);
+    }
+    const std::size_t carry = used_ - published_;
+    std::shared_ptr<char[]> next = acquire_chunk();
+    if (carry > 0) std::memcpy(next.get(), chunk_.get() + published_, carry);
+    chunk_ = std::move(next);
+    used_ = carry;
+    published_ = 0;
+}
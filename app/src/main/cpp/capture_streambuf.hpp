@@ -0,0 +1,60 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
+// Thread-safe std::streambuf that captures output into fixed-size chunks.
+// As soon as a write completes one or more lines, those lines are handed to the sink as a view into the chunk plus a
+// shared reference that keeps the chunk alive, so the writing thread copies each byte only once, into the chunk. The
+// sink may copy later (LogPipeline's consumer copies each record into its batch buffer). Once the last reference to
+// a full chunk is dropped, the chunk goes back to a small free list instead of being freed. A partial line stays in
+// the chunk until its newline arrives, or until the chunk fills up (the high-water mark); then the partial data is
+// handed over as-is, so a single huge line cannot stall capture.
+// Empty lines are skipped, so the sink never receives blank lines.
+class CaptureStreambuf : public std::streambuf {
+public:
+    // Receives one or more '\n'-separated lines without the trailing newline.
+    using Sink = std::function<void(std::shared_ptr<const void> keepalive, std::string_view lines)>;
+
+    static constexpr std::size_t kDefaultChunkSize = 16 * 1024;
+    // Retired chunks kept for reuse; more are freed.
+    static constexpr std::size_t kMaxFreeChunks = 8;
+
+    explicit CaptureStreambuf(Sink sink, std::size_t chunk_size = kDefaultChunkSize);
+    CaptureStreambuf(const CaptureStreambuf &) = delete;
+    CaptureStreambuf &operator=(const CaptureStreambuf &) = delete;
+    ~CaptureStreambuf() override;
+
+    // Hands over a trailing partial line, if any (end of run).
+    void drain();
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+private:
+    // Shared with the chunk deleters, which may run on another thread after the streambuf is gone.
+    struct ChunkPool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<char[]>> free;
+    };
+
+    std::shared_ptr<char[]> acquire_chunk();
+    void append_locked(const char *s, std::size_t n);
+    void publish_locked(std::size_t end);
+    void rotate_locked();
+
+    Sink sink_;
+    std::size_t chunk_size_;
+    std::mutex mutex_;
+    std::shared_ptr<ChunkPool> pool_;
+    std::shared_ptr<char[]> chunk_;
+    std::size_t used_ = 0;      // bytes written into chunk_
+    std::size_t published_ = 0; // bytes already handed to the sink (including consumed newlines)
+};
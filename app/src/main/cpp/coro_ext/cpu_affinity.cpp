@@ -0,0 +1,175 @@
+// All code comments are in English per repo policy.
+
+#include "cpu_affinity.hpp"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <utility>
+
+namespace coro_ext {
+
+namespace {
+
+// First unsigned integer in a sysfs attribute, or 0 when it is missing or unreadable.
+std::uint32_t read_attribute(const std::string &path) {
+    std::ifstream in{path};
+    std::uint64_t value = 0;
+    if (!(in >> value)) return 0;
+    return static_cast<std::uint32_t>(value);
+}
+
+std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+} // namespace
+
+cpu_topology::cpu_topology(std::vector<cpu_info> cpus) : cpus_(std::move(cpus)) {
+    // Capacity is only trusted when every CPU exports it; otherwise a CPU whose attribute could not be read would
+    // rank as the slowest. Frequency is the fallback.
+    by_capacity_ = !cpus_.empty() && std::all_of(cpus_.begin(), cpus_.end(), [](const cpu_info &c) {
+        return c.capacity > 0;
+    });
+}
+
+cpu_topology cpu_topology::detect(const std::string &sysfs_root) {
+    std::vector<cpu_info> cpus;
+    for (const int id : allowed_cpus()) {
+        const std::string dir = sysfs_root + "/cpu" + std::to_string(id);
+        cpu_info cpu;
+        cpu.id = id;
+        cpu.capacity = read_attribute(dir + "/cpu_capacity");
+        cpu.max_freq_khz = read_attribute(dir + "/cpufreq/cpuinfo_max_freq");
+        cpu.package = static_cast<int>(read_attribute(dir + "/topology/physical_package_id"));
+        cpus.push_back(cpu);
+    }
+    return cpu_topology{std::move(cpus)};
+}
+
+const cpu_topology &cpu_topology::system() {
+    static const cpu_topology topology = detect();
+    return topology;
+}
+
+std::uint32_t cpu_topology::rank(const cpu_info &cpu) const noexcept {
+    return by_capacity_ ? cpu.capacity : cpu.max_freq_khz;
+}
+
+// Sorted ascending, the ranks of one core type sit close together; the first rank more than the tolerance above its
+// predecessor starts the next type.
+std::uint32_t cpu_topology::performance_floor() const {
+    std::vector<std::uint64_t> ranks;
+    for (const auto &cpu : cpus_) ranks.push_back(rank(cpu));
+    std::sort(ranks.begin(), ranks.end());
+    for (std::size_t i = 1; i < ranks.size(); ++i) {
+        if (ranks[i] * 100 > ranks[i - 1] * (100 + class_tolerance_percent))
+            return static_cast<std::uint32_t>(ranks[i]);
+    }
+    return 0;
+}
+
+bool cpu_topology::heterogeneous() const {
+    return performance_floor() != 0;
+}
+
+std::vector<int> cpu_topology::all_cpus() const {
+    std::vector<int> ids;
+    for (const auto &cpu : cpus_) ids.push_back(cpu.id);
+    return ids;
+}
+
+std::vector<int> cpu_topology::performance_cpus() const {
+    const std::uint32_t floor = performance_floor();
+    std::vector<int> ids;
+    for (const auto &cpu : cpus_) {
+        if (rank(cpu) >= floor) ids.push_back(cpu.id);
+    }
+    return ids;
+}
+
+std::vector<int> cpu_topology::performance_cluster() const {
+    const std::vector<int> fastest = performance_cpus();
+    if (fastest.empty()) return fastest;
+    const auto package_of = [this](int id) {
+        return std::find_if(cpus_.begin(), cpus_.end(), [id](const cpu_info &c) { return c.id == id; })->package;
+    };
+    const int package = package_of(fastest.front());
+    std::vector<int> ids;
+    for (const int id : fastest) {
+        if (package_of(id) == package) ids.push_back(id);
+    }
+    return ids;
+}
+
+std::vector<int> cpu_topology::resolve(const cpu_placement &placement) const {
+    switch (placement.kind) {
+        case cpu_placement::policy::none:
+            return {};
+        case cpu_placement::policy::cpus: {
+            std::vector<int> ids;
+            for (const int id : placement.cpus) {
+                const bool allowed =
+                    std::any_of(cpus_.begin(), cpus_.end(), [id](const cpu_info &c) { return c.id == id; });
+                if (allowed && std::find(ids.begin(), ids.end(), id) == ids.end()) ids.push_back(id);
+            }
+            return ids;
+        }
+        case cpu_placement::policy::performance_cores:
+            return performance_cpus();
+        case cpu_placement::policy::performance_cluster:
+            return performance_cluster();
+    }
+    return {};
+}
+
+int pin_current_thread(std::span<const int> cpus) noexcept {
+    if (cpus.empty()) return 0;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) return -EINVAL;
+        CPU_SET(cpu, &set);
+    }
+    // pid 0 is the calling thread, not the whole process.
+    return ::sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -errno;
+}
+
+std::function<void(std::size_t)> thread_start_functor(const cpu_placement &placement,
+                                                      std::function<void(std::size_t)> next) {
+    return [cpus = cpu_topology::system().resolve(placement), per_thread = placement.one_cpu_per_thread,
+            next = std::move(next)](std::size_t index) {
+        if (per_thread && !cpus.empty()) {
+            (void)pin_current_thread(std::span{&cpus[index % cpus.size()], 1});
+        } else {
+            (void)pin_current_thread(cpus);
+        }
+        if (next) next(index);
+    };
+}
+
+std::function<void()> io_thread_start_functor(const cpu_placement &placement, std::function<void()> next) {
+    return [cpus = cpu_topology::system().resolve(placement), next = std::move(next)] {
+        (void)pin_current_thread(cpus);
+        if (next) next();
+    };
+}
+
+coro::io_scheduler::options place(coro::io_scheduler::options opts, const cpu_placement &placement) {
+    if (placement.kind == cpu_placement::policy::none) return opts;
+    opts.on_io_thread_start_functor = io_thread_start_functor(placement, std::move(opts.on_io_thread_start_functor));
+    opts.pool.on_thread_start_functor = thread_start_functor(placement, std::move(opts.pool.on_thread_start_functor));
+    return opts;
+}
+
+} // namespace coro_ext
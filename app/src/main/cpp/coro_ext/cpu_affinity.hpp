@@ -0,0 +1,97 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <coro/coro.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace coro_ext {
+
+// Where scheduler threads may run. libcoro's thread_pool and io_scheduler threads float over every CPU, so on
+// big.LITTLE SoCs latency-critical workers can land on efficiency cores, and on multi-socket hosts they migrate
+// between caches. A placement is applied by each thread to itself when it starts. On Linux and Android that is
+// sched_setaffinity(), which needs no privileges for the calling thread.
+struct cpu_placement {
+    enum class policy : std::uint8_t {
+        none,                // leave threads where the OS puts them
+        cpus,                // the CPUs listed in `cpus`
+        performance_cores,   // every CPU except those of the slowest core type
+        performance_cluster, // the performance cores on a single package, so all threads share one cache domain
+    };
+
+    policy kind = policy::none;
+    std::vector<int> cpus; // policy::cpus only
+    // Pin thread i to the single CPU set[i % set.size()] instead of letting it move within the whole set.
+    bool one_cpu_per_thread = false;
+};
+
+struct cpu_info {
+    int id = 0;
+    // Relative compute capacity from cpu_capacity (arm64: 1024 for the fastest core), 0 when the kernel has none.
+    std::uint32_t capacity = 0;
+    std::uint32_t max_freq_khz = 0; // cpufreq/cpuinfo_max_freq, 0 when unknown
+    int package = 0;                // topology/physical_package_id
+};
+
+// CPUs this process may run on (its affinity mask, which also reflects Android cpusets), with the sysfs attributes
+// used to rank them. Core types are told apart by cpu_capacity where the kernel exports it and by maximum frequency
+// otherwise. Neither is exact per core type (capacities are scaled from per-core measurements, frequencies vary with
+// binning), so CPUs whose ranks are within class_tolerance_percent of the next lower one count as the same type.
+// When neither is readable all CPUs count as one type.
+class cpu_topology {
+public:
+    static constexpr std::uint32_t class_tolerance_percent = 10;
+
+    cpu_topology() = default;
+    // A topology over known CPUs (e.g. a description cached from another run, or a test fixture).
+    explicit cpu_topology(std::vector<cpu_info> cpus);
+    // Reads `sysfs_root` (normally /sys/devices/system/cpu) for every CPU in the process affinity mask.
+    static cpu_topology detect(const std::string &sysfs_root = "/sys/devices/system/cpu");
+    // detect() of the running system, computed once.
+    static const cpu_topology &system();
+
+    const std::vector<cpu_info> &cpus() const noexcept { return cpus_; }
+    // True when the CPUs fall into more than one core type, e.g. big.LITTLE.
+    bool heterogeneous() const;
+    std::vector<int> all_cpus() const;
+    // Every CPU except those of the slowest core type, so on a prime + big + little SoC both the prime and the big
+    // cores; all CPUs when there is only one type.
+    std::vector<int> performance_cpus() const;
+    // performance_cpus() restricted to the package of the lowest-numbered one.
+    std::vector<int> performance_cluster() const;
+    // The CPU set a placement resolves to on this topology; empty for policy::none. Explicit CPUs that the process
+    // may not use are dropped.
+    std::vector<int> resolve(const cpu_placement &placement) const;
+
+private:
+    std::uint32_t rank(const cpu_info &cpu) const noexcept;
+    // Lowest rank above the slowest core type, or 0 when there is only one type.
+    std::uint32_t performance_floor() const;
+
+    std::vector<cpu_info> cpus_;
+    bool by_capacity_ = false;
+};
+
+// Restricts the calling thread to `cpus`. Returns 0 or -errno; an empty set is a no-op.
+int pin_current_thread(std::span<const int> cpus) noexcept;
+
+// on_thread_start_functor for coro::thread_pool::options (and coro_ext::work_stealing_pool::options): pins thread i
+// according to `placement`, then calls `next` if set. The CPU set is resolved once, when the functor is created.
+// Pinning is best effort: a thread that cannot be pinned keeps running where it is.
+std::function<void(std::size_t)> thread_start_functor(const cpu_placement &placement,
+                                                      std::function<void(std::size_t)> next = nullptr);
+// on_io_thread_start_functor for an io thread: pins it to the whole resolved set (even with one_cpu_per_thread,
+// since there is only one io thread), then calls `next` if set.
+std::function<void()> io_thread_start_functor(const cpu_placement &placement, std::function<void()> next = nullptr);
+
+// Applies `placement` to both the event thread and the task thread pool of an io_scheduler, so that resumed tasks
+// run on the same cluster as the epoll thread that woke them. Existing start functors are kept and called after
+// pinning.
+coro::io_scheduler::options place(coro::io_scheduler::options opts, const cpu_placement &placement);
+
+} // namespace coro_ext
@@ -0,0 +1,281 @@
+// All code comments are in English per repo policy.
+
+#include "frame_allocator.hpp"
+
+#include <sys/mman.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace coro_ext {
+
+namespace {
+
+// Size classes: 16-byte steps up to 512, 64-byte steps up to 1024, then 1536/2048/3072/4096.
+constexpr std::size_t kSmallStep = 16;
+constexpr std::size_t kSmallLimit = 512;
+constexpr std::size_t kMediumStep = 64;
+constexpr std::size_t kMediumLimit = 1024;
+constexpr std::array<std::size_t, 4> kLargeSizes{1536, 2048, 3072, 4096};
+constexpr std::size_t kSmallClasses = kSmallLimit / kSmallStep;
+constexpr std::size_t kMediumClasses = (kMediumLimit - kSmallLimit) / kMediumStep;
+constexpr std::size_t kClassCount = kSmallClasses + kMediumClasses + kLargeSizes.size();
+static_assert(kLargeSizes.back() == frame_allocator::max_pooled_size);
+
+// Chunks are aligned to their size so a block finds its chunk header by masking its address.
+constexpr std::size_t kChunkSize = frame_allocator::chunk_size;
+// Per-thread list length that triggers a spill, and the number of blocks moved per spill/refill.
+constexpr std::uint32_t kLocalLimit = 256;
+constexpr std::uint32_t kTransferBatch = 64;
+
+constexpr std::size_t class_index(std::size_t size) noexcept {
+    if (size <= kSmallLimit) return size == 0 ? 0 : (size + kSmallStep - 1) / kSmallStep - 1;
+    if (size <= kMediumLimit) return kSmallClasses + (size - kSmallLimit + kMediumStep - 1) / kMediumStep - 1;
+    std::size_t i = 0;
+    while (kLargeSizes[i] < size) ++i;
+    return kSmallClasses + kMediumClasses + i;
+}
+
+constexpr std::size_t class_size(std::size_t index) noexcept {
+    if (index < kSmallClasses) return (index + 1) * kSmallStep;
+    if (index < kSmallClasses + kMediumClasses) return kSmallLimit + (index - kSmallClasses + 1) * kMediumStep;
+    return kLargeSizes[index - kSmallClasses - kMediumClasses];
+}
+
+static_assert(class_size(class_index(1)) == 16 && class_size(class_index(17)) == 32);
+static_assert(class_size(class_index(513)) == 576 && class_size(class_index(1025)) == 1536);
+static_assert(class_index(4096) == kClassCount - 1);
+
+struct free_block {
+    free_block *next;
+};
+
+struct free_list {
+    free_block *head = nullptr;
+    std::uint32_t count = 0;
+
+    void push(free_block *block) noexcept {
+        block->next = head;
+        head = block;
+        ++count;
+    }
+
+    free_block *pop() noexcept {
+        free_block *block = head;
+        if (block) {
+            head = block->next;
+            --count;
+        }
+        return block;
+    }
+};
+
+// Start of every arena chunk. `carved` is only written by the thread carving from the chunk, and is final once
+// `retired` is set (release). `swept` is scratch space for trim(), which runs under the shared pool mutex.
+struct alignas(16) chunk_header {
+    std::uint32_t carved = 0;
+    std::uint32_t swept = 0;
+    std::atomic<bool> retired{false};
+};
+static_assert(sizeof(chunk_header) == 16);
+
+// chunk_header::swept value of a chunk trim() is releasing; above any real block count.
+constexpr std::uint32_t kCollected = UINT32_MAX;
+
+// Chunks are mapped directly (aligned by trimming an oversized mapping), so trim() returns them to the system and
+// no heap memory around them is touched.
+void *map_chunk() {
+    void *mapping = ::mmap(nullptr, 2 * kChunkSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) throw std::bad_alloc{};
+    const auto start = reinterpret_cast<std::uintptr_t>(mapping);
+    const std::uintptr_t aligned = (start + kChunkSize - 1) & ~(kChunkSize - 1);
+    if (aligned > start) ::munmap(mapping, aligned - start);
+    if (const std::uintptr_t tail = start + 2 * kChunkSize - (aligned + kChunkSize); tail > 0)
+        ::munmap(reinterpret_cast<void *>(aligned + kChunkSize), tail);
+    return reinterpret_cast<void *>(aligned);
+}
+
+chunk_header *chunk_of(void *block) noexcept {
+    return reinterpret_cast<chunk_header *>(reinterpret_cast<std::uintptr_t>(block) & ~(kChunkSize - 1));
+}
+
+// Bump allocation from the current chunk.
+struct arena {
+    chunk_header *chunk = nullptr;
+    char *bump = nullptr;
+    char *bump_end = nullptr;
+
+    void *carve(std::size_t size, std::atomic<std::size_t> &reserved) {
+        if (static_cast<std::size_t>(bump_end - bump) < size) {
+            // The rest of the old chunk is abandoned; at most one block's worth per chunk.
+            retire();
+            void *memory = map_chunk();
+            chunk = new (memory) chunk_header;
+            bump = static_cast<char *>(memory) + sizeof(chunk_header);
+            bump_end = static_cast<char *>(memory) + kChunkSize;
+            reserved.fetch_add(kChunkSize, std::memory_order_relaxed);
+        }
+        void *ptr = bump;
+        bump += size;
+        ++chunk->carved;
+        return ptr;
+    }
+
+    void retire() noexcept {
+        if (chunk) chunk->retired.store(true, std::memory_order_release);
+        chunk = nullptr;
+        bump = bump_end = nullptr;
+    }
+};
+
+// Blocks spilled by threads with too many free blocks (or by exiting threads), shared by everyone. Exiting threads
+// carve from the shared arena.
+struct shared_pool {
+    std::mutex mutex;
+    std::array<free_list, kClassCount> lists;
+    arena exit_arena;
+    std::atomic<std::size_t> reserved{0};
+};
+
+shared_pool &shared() {
+    // Leaked on purpose: threads may free frames during static destruction.
+    static auto *pool = new shared_pool;
+    return *pool;
+}
+
+struct thread_cache {
+    std::array<free_list, kClassCount> lists;
+    arena chunks;
+
+    bool refill(std::size_t index) noexcept {
+        auto &pool = shared();
+        std::lock_guard<std::mutex> lk(pool.mutex);
+        free_list &from = pool.lists[index];
+        for (std::uint32_t i = 0; i < kTransferBatch && from.head; ++i) lists[index].push(from.pop());
+        return lists[index].head != nullptr;
+    }
+
+    void spill(std::size_t index, std::uint32_t blocks) noexcept {
+        auto &pool = shared();
+        std::lock_guard<std::mutex> lk(pool.mutex);
+        for (std::uint32_t i = 0; i < blocks && lists[index].head; ++i) pool.lists[index].push(lists[index].pop());
+    }
+
+    void spill_all() noexcept {
+        for (std::size_t i = 0; i < kClassCount; ++i) spill(i, UINT32_MAX);
+    }
+
+    ~thread_cache() {
+        spill_all();
+        chunks.retire();
+    }
+};
+
+// The cache pointer outlives the cache object itself: it is cleared in the owner's destructor so frames freed
+// later during thread exit go straight to the shared pool.
+thread_local thread_cache *tl_cache = nullptr;
+thread_local bool tl_cache_destroyed = false;
+
+struct thread_cache_owner {
+    thread_cache cache;
+    thread_cache_owner() noexcept { tl_cache = &cache; }
+    ~thread_cache_owner() {
+        tl_cache = nullptr;
+        tl_cache_destroyed = true;
+    }
+};
+
+thread_cache *local_cache() noexcept {
+    if (tl_cache || tl_cache_destroyed) return tl_cache;
+    thread_local thread_cache_owner owner;
+    return tl_cache;
+}
+
+} // namespace
+
+void *frame_allocator::allocate(std::size_t size) {
+    if (size > max_pooled_size) return ::operator new(size);
+    const std::size_t index = class_index(size);
+    thread_cache *cache = local_cache();
+    if (!cache) {
+        // Thread is exiting: serve from the shared pool and the shared arena without a cache.
+        auto &pool = shared();
+        std::lock_guard<std::mutex> lk(pool.mutex);
+        if (free_block *block = pool.lists[index].pop()) return block;
+        return pool.exit_arena.carve(class_size(index), pool.reserved);
+    }
+    if (free_block *block = cache->lists[index].pop()) return block;
+    if (cache->refill(index)) return cache->lists[index].pop();
+    return cache->chunks.carve(class_size(index), shared().reserved);
+}
+
+void frame_allocator::deallocate(void *ptr, std::size_t size) noexcept {
+    if (!ptr) return;
+    if (size > max_pooled_size) {
+        ::operator delete(ptr, size);
+        return;
+    }
+    const std::size_t index = class_index(size);
+    auto *block = static_cast<free_block *>(ptr);
+    thread_cache *cache = local_cache();
+    if (!cache) {
+        auto &pool = shared();
+        std::lock_guard<std::mutex> lk(pool.mutex);
+        pool.lists[index].push(block);
+        return;
+    }
+    free_list &list = cache->lists[index];
+    list.push(block);
+    if (list.count > kLocalLimit) cache->spill(index, kTransferBatch);
+}
+
+std::size_t frame_allocator::trim() noexcept {
+    if (thread_cache *cache = local_cache()) cache->spill_all();
+    auto &pool = shared();
+    std::vector<chunk_header *> released;
+    {
+        std::lock_guard<std::mutex> lk(pool.mutex);
+        // Count the shared free blocks of every retired chunk. A chunk whose blocks are all here is unused: nothing
+        // holds one of its blocks and nothing carves from it any more.
+        for (free_list &list : pool.lists) {
+            for (free_block *block = list.head; block; block = block->next) {
+                chunk_header *chunk = chunk_of(block);
+                if (chunk->retired.load(std::memory_order_acquire)) ++chunk->swept;
+            }
+        }
+        for (free_list &list : pool.lists) {
+            free_list kept;
+            while (free_block *block = list.pop()) {
+                chunk_header *chunk = chunk_of(block);
+                if (chunk->swept == kCollected) continue; // dropped with its chunk
+                if (chunk->retired.load(std::memory_order_relaxed) && chunk->swept == chunk->carved) {
+                    chunk->swept = kCollected;
+                    released.push_back(chunk);
+                } else {
+                    kept.push(block);
+                }
+            }
+            list = kept;
+        }
+        for (free_list &list : pool.lists) {
+            for (free_block *block = list.head; block; block = block->next) chunk_of(block)->swept = 0;
+        }
+    }
+    for (chunk_header *chunk : released) {
+        chunk->~chunk_header();
+        ::munmap(chunk, kChunkSize);
+    }
+    const std::size_t bytes = released.size() * kChunkSize;
+    pool.reserved.fetch_sub(bytes, std::memory_order_relaxed);
+    return bytes;
+}
+
+std::size_t frame_allocator::reserved_bytes() noexcept {
+    return shared().reserved.load(std::memory_order_relaxed);
+}
+
+} // namespace coro_ext
@@ -0,0 +1,45 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <cstddef>
+
+namespace coro_ext {
+
+// Size-class allocator for coroutine frames.
+// Every thread keeps a free list per size class and carves new blocks from 64 KiB arena chunks, so allocating and
+// freeing a frame is a few pointer operations with no locking. Frames freed on another thread (common with thread
+// pools) go to that thread's lists; lists that grow past a limit spill a batch to a shared pool, which threads
+// refill from before carving new memory. The footprint follows the peak number of live frames, without per-allocation
+// headers; trim() hands chunks whose frames have all been freed back to the system after a burst.
+// Frames larger than max_pooled_size fall through to the global operator new.
+//
+// Only promise types that derive from pooled_frame use it. coro::task and coro::generator define their promises in
+// the libcoro submodule and keep using the global operator new.
+class frame_allocator {
+public:
+    static constexpr std::size_t max_pooled_size = 4096;
+    // Arena chunk size; every chunk starts with a 16-byte header.
+    static constexpr std::size_t chunk_size = 64 * 1024;
+
+    static void *allocate(std::size_t size);
+    static void deallocate(void *ptr, std::size_t size) noexcept;
+
+    // Moves the calling thread's free blocks to the shared pool, then frees every chunk whose blocks are all in the
+    // shared pool. Blocks cached by other threads keep their chunks, and so does the chunk each thread is carving from
+    // (until the thread exits). Takes the shared lock for a walk over every shared free block: call it when idle,
+    // not per frame. Returns the bytes released.
+    static std::size_t trim() noexcept;
+
+    // Bytes currently reserved in arena chunks, across all threads.
+    static std::size_t reserved_bytes() noexcept;
+};
+
+// Opt-in mixin for promise types: a coroutine whose promise derives from pooled_frame gets its frame from
+// frame_allocator. The compiler passes the frame size to the sized operator delete, so blocks carry no header.
+//   struct promise_type : coro_ext::pooled_frame { ... };
+struct pooled_frame {
+    static void *operator new(std::size_t size) { return frame_allocator::allocate(size); }
+    static void operator delete(void *ptr, std::size_t size) noexcept { frame_allocator::deallocate(ptr, size); }
+};
+
+} // namespace coro_ext
@@ -0,0 +1,447 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace coro_ext {
+
+// Bounded multi-producer/multi-consumer ring buffer with the awaitable surface of coro::ring_buffer: produce()
+// suspends while the buffer is full, consume() suspends while it is empty.
+//
+// The fast path is lock-free: every slot carries a sequence number that says whether it is free or filled for a given
+// lap (Vyukov's bounded MPMC queue), and producers/consumers claim positions with one CAS on their own cache-line
+// padded index. produce_batch()/consume_batch() claim up to N consecutive ready slots with that single CAS, so a batch
+// costs one synchronization instead of N. Only coroutines that actually have to wait take the mutex, to queue
+// themselves; whoever moves elements next completes their operation under that mutex and resumes them inline (after
+// releasing it), like coro::ring_buffer does.
+//
+// shutdown() fails pending and future produce operations; consumers keep draining what is left and then observe the
+// stop (consume() returns std::nullopt, consume_batch() returns 0). Shutdown closes the enqueue index itself, so every
+// produce either claimed its slot before the stop (and succeeds) or fails; a consumer only reports the stop once every
+// claimed slot has been consumed, waiting briefly for producers that claimed a slot but have not published it yet.
+template <typename element, std::size_t num_elements>
+class mpmc_ring_buffer {
+    static_assert(num_elements >= 2 && (num_elements & (num_elements - 1)) == 0,
+                  "num_elements must be a power of two");
+    // A throwing move in the middle of a batch would leave claimed slots unpublished.
+    static_assert(std::is_nothrow_move_constructible_v<element>, "element must be nothrow move constructible");
+
+    struct waiter {
+        waiter *next = nullptr;
+        std::coroutine_handle<> handle;
+        bool stopped = false;
+
+        // Called under the waiter mutex; moves what it can and returns true once the operation is complete.
+        virtual bool try_finish(mpmc_ring_buffer &rb, bool &moved) noexcept = 0;
+
+    protected:
+        ~waiter() = default;
+    };
+
+    struct waiter_list {
+        waiter *head = nullptr;
+        waiter *tail = nullptr;
+
+        void push_back(waiter *w) noexcept {
+            w->next = nullptr;
+            if (tail) {
+                tail->next = w;
+            } else {
+                head = w;
+            }
+            tail = w;
+        }
+
+        waiter *pop_front() noexcept {
+            waiter *w = head;
+            head = w->next;
+            if (!head) tail = nullptr;
+            return w;
+        }
+    };
+
+public:
+    class produce_operation final : waiter {
+    public:
+        produce_operation(mpmc_ring_buffer &rb, element value) noexcept : rb_(rb), value_(std::move(value)) {}
+
+        bool await_ready() noexcept {
+            if (rb_.stopped()) {
+                this->stopped = true;
+                return true;
+            }
+            return done_ = rb_.produce_n(&value_, 1) == 1;
+        }
+        bool await_suspend(std::coroutine_handle<> handle) noexcept { return rb_.suspend(this, handle, false); }
+        // True when the element was stored, false when the buffer was shut down first.
+        bool await_resume() const noexcept { return done_; }
+
+    private:
+        bool try_finish(mpmc_ring_buffer &rb, bool &moved) noexcept override {
+            done_ = moved = rb.try_produce_n(&value_, 1) == 1;
+            return done_;
+        }
+
+        mpmc_ring_buffer &rb_;
+        element value_;
+        bool done_ = false;
+    };
+
+    class consume_operation final : waiter {
+    public:
+        explicit consume_operation(mpmc_ring_buffer &rb) noexcept : rb_(rb) {}
+
+        bool await_ready() noexcept { return rb_.consume_into(result_) || rb_.stopped(); }
+        bool await_suspend(std::coroutine_handle<> handle) noexcept { return rb_.suspend(this, handle, true); }
+        // The consumed element, or std::nullopt once the buffer is shut down and drained.
+        std::optional<element> await_resume() noexcept {
+            // Only a stop completes the operation without an element.
+            if (!result_) rb_.consume_after_stop(result_);
+            return std::move(result_);
+        }
+
+    private:
+        bool try_finish(mpmc_ring_buffer &rb, bool &moved) noexcept override {
+            moved = rb.try_consume_into(result_);
+            return moved;
+        }
+
+        mpmc_ring_buffer &rb_;
+        std::optional<element> result_;
+    };
+
+    class produce_batch_operation final : waiter {
+    public:
+        produce_batch_operation(mpmc_ring_buffer &rb, std::span<element> items) noexcept : rb_(rb), items_(items) {}
+
+        bool await_ready() noexcept {
+            if (rb_.stopped()) {
+                this->stopped = true;
+                return true;
+            }
+            produced_ = rb_.produce_n(items_.data(), items_.size());
+            return produced_ == items_.size();
+        }
+        bool await_suspend(std::coroutine_handle<> handle) noexcept { return rb_.suspend(this, handle, false); }
+        // Number of elements moved into the buffer; less than items.size() only after shutdown.
+        std::size_t await_resume() const noexcept { return produced_; }
+
+    private:
+        bool try_finish(mpmc_ring_buffer &rb, bool &moved) noexcept override {
+            const std::size_t n = rb.try_produce_n(items_.data() + produced_, items_.size() - produced_);
+            produced_ += n;
+            moved = n > 0;
+            return produced_ == items_.size();
+        }
+
+        mpmc_ring_buffer &rb_;
+        std::span<element> items_;
+        std::size_t produced_ = 0;
+    };
+
+    class consume_batch_operation final : waiter {
+    public:
+        consume_batch_operation(mpmc_ring_buffer &rb, std::span<element> out) noexcept : rb_(rb), out_(out) {}
+
+        bool await_ready() noexcept {
+            consumed_ = rb_.consume_n(out_.data(), out_.size());
+            return consumed_ > 0 || out_.empty() || rb_.stopped();
+        }
+        bool await_suspend(std::coroutine_handle<> handle) noexcept { return rb_.suspend(this, handle, true); }
+        // Number of elements written to the front of `out`: at least one, or 0 once shut down and drained.
+        std::size_t await_resume() noexcept {
+            if (consumed_ == 0 && !out_.empty()) consumed_ = rb_.consume_n_after_stop(out_.data(), out_.size());
+            return consumed_;
+        }
+
+    private:
+        bool try_finish(mpmc_ring_buffer &rb, bool &moved) noexcept override {
+            consumed_ = rb.try_consume_n(out_.data(), out_.size());
+            moved = consumed_ > 0;
+            return moved;
+        }
+
+        mpmc_ring_buffer &rb_;
+        std::span<element> out_;
+        std::size_t consumed_ = 0;
+    };
+
+    mpmc_ring_buffer() {
+        for (std::size_t i = 0; i < num_elements; ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mpmc_ring_buffer(const mpmc_ring_buffer &) = delete;
+    mpmc_ring_buffer &operator=(const mpmc_ring_buffer &) = delete;
+    ~mpmc_ring_buffer() {
+        std::optional<element> discard;
+        while (try_consume_into(discard)) discard.reset();
+    }
+
+    // Stores `value`, suspending while the buffer is full. Resolves to false if the buffer is shut down.
+    [[nodiscard]] produce_operation produce(element value) noexcept {
+        return produce_operation{*this, std::move(value)};
+    }
+    // Takes one element, suspending while the buffer is empty.
+    [[nodiscard]] consume_operation consume() noexcept { return consume_operation{*this}; }
+    // Moves every element of `items` into the buffer (leaving them moved-from), suspending whenever it is full.
+    // Ready slots are claimed in runs, one CAS per run.
+    [[nodiscard]] produce_batch_operation produce_batch(std::span<element> items) noexcept {
+        return produce_batch_operation{*this, items};
+    }
+    // Moves up to out.size() elements into `out`, suspending only while the buffer is empty.
+    [[nodiscard]] consume_batch_operation consume_batch(std::span<element> out) noexcept {
+        return consume_batch_operation{*this, out};
+    }
+
+    // Non-suspending variants; they never wait and never fail because of other threads being slow to wake.
+    bool try_produce(element &value) noexcept { return !stopped() && produce_n(&value, 1) == 1; }
+    std::optional<element> try_consume() noexcept {
+        std::optional<element> result;
+        consume_into(result);
+        return result;
+    }
+
+    // Fails pending and future produce operations and wakes every waiting consumer. Idempotent.
+    void shutdown() noexcept {
+        waiter_list ready;
+        {
+            std::lock_guard<std::mutex> lk(waiter_mutex_);
+            // Closed before stopped_ is published: whoever sees stopped() also sees the final enqueue index.
+            enqueue_pos_.fetch_or(closed_bit, std::memory_order_acq_rel);
+            stopped_.store(true, std::memory_order_release);
+            for (waiter_list *list : {&producers_, &consumers_}) {
+                while (list->head) {
+                    waiter *w = list->pop_front();
+                    w->stopped = true;
+                    ready.push_back(w);
+                }
+            }
+            producer_waiters_.store(0, std::memory_order_relaxed);
+            consumer_waiters_.store(0, std::memory_order_relaxed);
+        }
+        resume_all(ready);
+    }
+
+    bool stopped() const noexcept { return stopped_.load(std::memory_order_acquire); }
+
+    // Snapshot; may be stale by the time it is returned.
+    std::size_t size() const noexcept {
+        const std::uint64_t tail = enqueue_pos_.load(std::memory_order_acquire) & ~closed_bit;
+        const std::uint64_t head = dequeue_pos_.load(std::memory_order_acquire);
+        return tail > head ? static_cast<std::size_t>(tail - head) : 0;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    static constexpr std::size_t capacity() noexcept { return num_elements; }
+
+private:
+    static constexpr std::uint64_t mask = num_elements - 1;
+    // Set in enqueue_pos_ by shutdown(); a producer's claim CAS fails once it is set.
+    static constexpr std::uint64_t closed_bit = std::uint64_t{1} << 63;
+
+    struct slot {
+        std::atomic<std::uint64_t> sequence;
+        alignas(element) unsigned char storage[sizeof(element)];
+
+        element *get() noexcept { return std::launder(reinterpret_cast<element *>(storage)); }
+    };
+
+    // Claims the longest run (up to n) of slots that are free for the current lap and moves items into them.
+    std::size_t try_produce_n(element *items, std::size_t n) noexcept {
+        if (n == 0) return 0;
+        std::uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (pos & closed_bit) return 0;
+            std::size_t run = 0;
+            while (run < n && slots_[(pos + run) & mask].sequence.load(std::memory_order_acquire) == pos + run) ++run;
+            if (run == 0) {
+                const std::uint64_t seq = slots_[pos & mask].sequence.load(std::memory_order_acquire);
+                // The slot still holds an element from the previous lap: full.
+                if (static_cast<std::int64_t>(seq - pos) < 0) return 0;
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + run, std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i < run; ++i) {
+                    slot &s = slots_[(pos + i) & mask];
+                    ::new (static_cast<void *>(s.storage)) element(std::move(items[i]));
+                    s.sequence.store(pos + i + 1, std::memory_order_release);
+                }
+                return run;
+            }
+        }
+    }
+
+    // Claims the longest run (up to n) of published slots and moves their elements into out.
+    std::size_t try_consume_n(element *out, std::size_t n) noexcept {
+        if (n == 0) return 0;
+        std::uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            std::size_t run = 0;
+            while (run < n &&
+                   slots_[(pos + run) & mask].sequence.load(std::memory_order_acquire) == pos + run + 1)
+                ++run;
+            if (run == 0) {
+                const std::uint64_t seq = slots_[pos & mask].sequence.load(std::memory_order_acquire);
+                // Not published for this lap yet (empty, or a producer is still writing it).
+                if (static_cast<std::int64_t>(seq - (pos + 1)) < 0) return 0;
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + run, std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i < run; ++i) {
+                    slot &s = slots_[(pos + i) & mask];
+                    element *e = s.get();
+                    out[i] = std::move(*e);
+                    e->~element();
+                    s.sequence.store(pos + i + num_elements, std::memory_order_release);
+                }
+                return run;
+            }
+        }
+    }
+
+    bool try_consume_into(std::optional<element> &result) noexcept {
+        std::uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            slot &s = slots_[pos & mask];
+            const std::uint64_t seq = s.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::int64_t>(seq - (pos + 1));
+            if (diff < 0) return false;
+            if (diff > 0) {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            } else if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                element *e = s.get();
+                result.emplace(std::move(*e));
+                e->~element();
+                s.sequence.store(pos + num_elements, std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    // Fast-path wrappers: after moving elements, complete waiters on the other side if there are any. The seq_cst
+    // fence pairs with the one in suspend(): either the waiter's retry sees our slots, or we see its registration.
+    std::size_t produce_n(element *items, std::size_t n) noexcept {
+        const std::size_t moved = try_produce_n(items, n);
+        if (moved > 0) notify(consumer_waiters_);
+        return moved;
+    }
+    std::size_t consume_n(element *out, std::size_t n) noexcept {
+        const std::size_t moved = try_consume_n(out, n);
+        if (moved > 0) notify(producer_waiters_);
+        return moved;
+    }
+    bool consume_into(std::optional<element> &result) noexcept {
+        if (!try_consume_into(result)) return false;
+        notify(producer_waiters_);
+        return true;
+    }
+
+    // Only meaningful once stopped: every slot claimed before the enqueue index was closed has been taken by a
+    // consumer. Until then, a claimed slot that is not readable yet is still being published by its producer.
+    bool drained() const noexcept {
+        const std::uint64_t tail = enqueue_pos_.load(std::memory_order_acquire) & ~closed_bit;
+        return dequeue_pos_.load(std::memory_order_acquire) >= tail;
+    }
+    // Consume paths after a stop: retry while claimed slots are still being published.
+    void consume_after_stop(std::optional<element> &result) noexcept {
+        while (!consume_into(result) && !drained()) std::this_thread::yield();
+    }
+    std::size_t consume_n_after_stop(element *out, std::size_t n) noexcept {
+        for (;;) {
+            if (const std::size_t moved = consume_n(out, n); moved > 0 || drained()) return moved;
+            std::this_thread::yield();
+        }
+    }
+
+    void notify(const std::atomic<std::uint32_t> &waiters) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) wake_waiters();
+    }
+
+    bool suspend(waiter *w, std::coroutine_handle<> handle, bool consumer) noexcept {
+        w->handle = handle;
+        auto &count = consumer ? consumer_waiters_ : producer_waiters_;
+        for (;;) {
+            bool moved = false;
+            bool finished = false;
+            {
+                std::lock_guard<std::mutex> lk(waiter_mutex_);
+                if (stopped()) {
+                    w->stopped = true;
+                    return false;
+                }
+                count.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                // Retry now that we are registered: anything published from here on will find us.
+                finished = w->try_finish(*this, moved);
+                if (!finished && !moved) {
+                    // Once queued, the operation (and possibly this buffer) may be gone; touch nothing after this.
+                    (consumer ? consumers_ : producers_).push_back(w);
+                    return true;
+                }
+                count.fetch_sub(1, std::memory_order_relaxed);
+            }
+            // A partial batch moved elements, which may unblock the other side; let it run before queueing.
+            notify(consumer ? producer_waiters_ : consumer_waiters_);
+            if (finished) return false;
+        }
+    }
+
+    void wake_waiters() noexcept {
+        waiter_list ready;
+        {
+            std::lock_guard<std::mutex> lk(waiter_mutex_);
+            // Completing consumers frees slots for producers and vice versa; loop until neither side moves.
+            bool progress = true;
+            while (progress) {
+                progress = drain(consumers_, consumer_waiters_, ready);
+                progress = drain(producers_, producer_waiters_, ready) || progress;
+            }
+        }
+        resume_all(ready);
+    }
+
+    bool drain(waiter_list &list, std::atomic<std::uint32_t> &count, waiter_list &ready) noexcept {
+        bool progress = false;
+        while (list.head) {
+            bool moved = false;
+            const bool finished = list.head->try_finish(*this, moved);
+            progress = progress || moved;
+            if (!finished) break;
+            ready.push_back(list.pop_front());
+            count.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return progress;
+    }
+
+    static void resume_all(waiter_list &ready) noexcept {
+        while (ready.head) {
+            // The waiter lives in the coroutine frame being resumed; read it before resuming.
+            waiter *w = ready.pop_front();
+            w->handle.resume();
+        }
+    }
+
+    alignas(64) std::atomic<std::uint64_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::uint64_t> dequeue_pos_{0};
+    alignas(64) std::atomic<std::uint32_t> producer_waiters_{0};
+    std::atomic<std::uint32_t> consumer_waiters_{0};
+    std::atomic<bool> stopped_{false};
+    std::mutex waiter_mutex_;
+    waiter_list producers_;
+    waiter_list consumers_;
+    alignas(64) std::unique_ptr<slot[]> slots_{new slot[num_elements]};
+};
+
+} // namespace coro_ext
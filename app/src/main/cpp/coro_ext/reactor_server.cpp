@@ -0,0 +1,171 @@
+// All code comments are in English per repo policy.
+
+#include "reactor_server.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace coro_ext {
+
+namespace {
+
+[[noreturn]] void throw_socket_error(int fd, const char *what) {
+    const int err = errno;
+    if (fd >= 0) ::close(fd);
+    throw std::system_error(err, std::generic_category(), std::string("coro_ext::reactor_server: ") + what);
+}
+
+} // namespace
+
+reactor_server::reactor_server(options opts, connection_handler handler)
+    : opts_(std::move(opts)), handler_(std::move(handler)) {
+    if (opts_.reactor_count == 0) opts_.reactor_count = std::max(1u, std::thread::hardware_concurrency());
+    // Bind every listener before starting any event thread, so a failure leaves nothing running.
+    try {
+        for (std::uint32_t i = 0; i < opts_.reactor_count; ++i) {
+            auto r = std::make_unique<reactor>();
+            r->listen_fd = open_listener(port_ != 0 ? port_ : opts_.port);
+            reactors_.push_back(std::move(r));
+        }
+    } catch (...) {
+        for (auto &r : reactors_) ::close(r->listen_fd);
+        throw;
+    }
+
+    const auto pin = thread_start_functor(opts_.placement);
+    for (std::size_t i = 0; i < reactors_.size(); ++i) {
+        coro::io_scheduler::options scheduler_opts{};
+        // Connections never leave their reactor, so tasks run on the event thread itself.
+        scheduler_opts.execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline;
+        if (opts_.placement.kind != cpu_placement::policy::none) {
+            scheduler_opts.on_io_thread_start_functor = [pin, i] { pin(i); };
+        }
+        reactors_[i]->scheduler = coro::io_scheduler::make_shared(std::move(scheduler_opts));
+    }
+}
+
+reactor_server::~reactor_server() {
+    shutdown();
+    for (auto &r : reactors_) ::close(r->listen_fd);
+}
+
+int reactor_server::open_listener(std::uint16_t port) {
+    sockaddr_storage addr{};
+    socklen_t addr_size = 0;
+    auto *v4 = reinterpret_cast<sockaddr_in *>(&addr);
+    auto *v6 = reinterpret_cast<sockaddr_in6 *>(&addr);
+    if (::inet_pton(AF_INET, opts_.address.c_str(), &v4->sin_addr) == 1) {
+        v4->sin_family = AF_INET;
+        v4->sin_port = htons(port);
+        addr_size = sizeof(sockaddr_in);
+    } else if (::inet_pton(AF_INET6, opts_.address.c_str(), &v6->sin6_addr) == 1) {
+        v6->sin6_family = AF_INET6;
+        v6->sin6_port = htons(port);
+        addr_size = sizeof(sockaddr_in6);
+    } else {
+        errno = EINVAL;
+        throw_socket_error(-1, "invalid listen address");
+    }
+
+    const int fd = ::socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw_socket_error(fd, "socket");
+    const int one = 1;
+    if (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0) throw_socket_error(fd, "SO_REUSEADDR");
+    if (::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) throw_socket_error(fd, "SO_REUSEPORT");
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), addr_size) != 0) throw_socket_error(fd, "bind");
+    if (::listen(fd, opts_.backlog) != 0) throw_socket_error(fd, "listen");
+    if (port_ == 0) {
+        // The first listener fixes the port (possibly ephemeral) that the others join.
+        if (::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &addr_size) != 0) {
+            throw_socket_error(fd, "getsockname");
+        }
+        port_ = ntohs(addr.ss_family == AF_INET ? v4->sin_port : v6->sin6_port);
+    }
+    return fd;
+}
+
+coro::task<void> reactor_server::run() {
+    std::vector<coro::task<void>> loops;
+    loops.reserve(reactors_.size());
+    for (auto &r : reactors_) loops.emplace_back(accept_loop(*r));
+    co_await coro::when_all(std::move(loops));
+    co_return;
+}
+
+coro::task<void> reactor_server::accept_loop(reactor &r) {
+    co_await r.scheduler->schedule();
+    coro::task_container<coro::io_scheduler> connections{r.scheduler};
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (co_await r.scheduler->poll(r.listen_fd, coro::poll_op::read) != coro::poll_status::event) break;
+        // Drain the accept queue before polling again. accept4 fails with EAGAIN once it is empty and with EINVAL
+        // after shutdown(); a connection aborted while queued (ECONNABORTED) is skipped.
+        bool back_off = false;
+        for (;;) {
+            const int fd = ::accept4(r.listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                const int err = errno;
+                if (err == EINTR || err == ECONNABORTED) continue;
+                back_off = err != EAGAIN && err != EWOULDBLOCK && err != EINVAL;
+                break;
+            }
+            if (opts_.no_delay) {
+                const int one = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            }
+            r.accepted.fetch_add(1, std::memory_order_relaxed);
+            connections.start(serve(r, fd));
+        }
+        // Out of descriptors or memory (EMFILE, ENFILE, ENOBUFS, ENOMEM): the connection stays queued and the
+        // listener stays readable, so polling again right away would spin. Give open connections time to close.
+        if (back_off && !stopping_.load(std::memory_order_acquire)) {
+            co_await r.scheduler->yield_for(opts_.accept_backoff);
+        }
+    }
+    co_await connections.garbage_collect_and_yield_until_empty();
+    co_return;
+}
+
+coro::task<void> reactor_server::serve(reactor &r, int fd) {
+    co_await r.scheduler->schedule();
+    {
+        std::lock_guard lock{r.connections_mutex};
+        // Accepted after shutdown() went over the open connections: stop this one straight away.
+        if (stopping_.load(std::memory_order_acquire)) ::shutdown(fd, SHUT_RDWR);
+        r.open_fds.push_back(fd);
+    }
+    try {
+        co_await handler_(r.scheduler, fd);
+    } catch (...) {
+        // A failing connection must not take its reactor down; the socket is closed either way.
+    }
+    {
+        // Closed under the lock, so shutdown() never touches a descriptor number that has been reused.
+        std::lock_guard lock{r.connections_mutex};
+        std::erase(r.open_fds, fd);
+        ::close(fd);
+    }
+    co_return;
+}
+
+void reactor_server::shutdown() noexcept {
+    if (stopping_.exchange(true, std::memory_order_acq_rel)) return;
+    for (auto &r : reactors_) {
+        // Shutting a listening socket down wakes its poll() and makes further accept4() calls fail.
+        ::shutdown(r->listen_fd, SHUT_RDWR);
+        // Open connections see end of stream on read and EPIPE on write, so their handlers return.
+        std::lock_guard lock{r->connections_mutex};
+        for (const int fd : r->open_fds) ::shutdown(fd, SHUT_RDWR);
+    }
+}
+
+} // namespace coro_ext
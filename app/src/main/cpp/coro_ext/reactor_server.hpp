@@ -0,0 +1,97 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include "cpu_affinity.hpp"
+
+#include <coro/coro.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace coro_ext {
+
+// Multi-reactor TCP server. coro::net::tcp::server accepts on one listening socket driven by one io_scheduler, so
+// accepting and every connection's I/O stay on a single event thread. reactor_server opens reactor_count listeners
+// bound to the same address with SO_REUSEPORT, each owned by its own io_scheduler (one event thread per reactor).
+// The kernel hashes incoming connections across the listeners. Each connection is then served entirely by the
+// reactor that accepted it, with no cross-thread hand-off.
+//
+// Handlers get the reactor's scheduler and a non-blocking connected socket. They do I/O with scheduler->poll() and
+// read()/write(), or with coro_ext::write_all()/read_exact(). The server closes the socket when the handler returns.
+// Handlers must return once a read reports end of stream or a write fails: that is how shutdown() stops them.
+//
+// With SO_REUSEPORT, connections still queued on a listener when it closes are reset. shutdown() is therefore for
+// tearing the server down, not for draining. Destroy the server only after run() has returned, or if it never ran.
+class reactor_server {
+public:
+    using connection_handler = std::function<coro::task<void>(std::shared_ptr<coro::io_scheduler> scheduler, int fd)>;
+
+    struct options {
+        // IPv4 or IPv6 literal to listen on.
+        std::string address = "127.0.0.1";
+        // 0 picks an ephemeral port (see port()), shared by every listener.
+        std::uint16_t port = 0;
+        // Number of listeners / io_schedulers; 0 means std::thread::hardware_concurrency().
+        std::uint32_t reactor_count = 0;
+        int backlog = 128;
+        // TCP_NODELAY on accepted sockets.
+        bool no_delay = true;
+        // Pause before accepting again after accept4() runs out of resources (EMFILE, ENFILE, ENOBUFS, ENOMEM).
+        std::chrono::milliseconds accept_backoff{10};
+        // Event thread placement; with one_cpu_per_thread, reactor i runs on the i-th CPU of the resolved set.
+        cpu_placement placement{};
+    };
+
+    // Opens and binds every listener and starts the reactors' event threads.
+    // Throws std::system_error when a socket cannot be set up, e.g. when SO_REUSEPORT is unsupported or the port is
+    // taken by a socket without it.
+    reactor_server(options opts, connection_handler handler);
+    reactor_server(const reactor_server &) = delete;
+    reactor_server &operator=(const reactor_server &) = delete;
+    ~reactor_server();
+
+    // Accepts on every reactor until shutdown(), then waits for the connections still being served to finish.
+    coro::task<void> run();
+    // Stops accepting and shuts down (SHUT_RDWR) the sockets of open connections. run() returns once every
+    // connection's handler has returned. Thread safe, idempotent.
+    void shutdown() noexcept;
+
+    std::uint16_t port() const noexcept { return port_; }
+    std::size_t reactor_count() const noexcept { return reactors_.size(); }
+    const std::shared_ptr<coro::io_scheduler> &scheduler(std::size_t reactor) const noexcept {
+        return reactors_[reactor]->scheduler;
+    }
+    // Connections accepted so far by one reactor; shows how evenly the kernel spreads load.
+    std::uint64_t accepted(std::size_t reactor) const noexcept {
+        return reactors_[reactor]->accepted.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct reactor {
+        int listen_fd = -1;
+        std::shared_ptr<coro::io_scheduler> scheduler;
+        std::atomic<std::uint64_t> accepted{0};
+        // Sockets of connections being served; shutdown() stops them from another thread.
+        std::mutex connections_mutex;
+        std::vector<int> open_fds;
+    };
+
+    int open_listener(std::uint16_t port);
+    coro::task<void> accept_loop(reactor &r);
+    coro::task<void> serve(reactor &r, int fd);
+
+    options opts_;
+    connection_handler handler_;
+    std::uint16_t port_ = 0;
+    std::vector<std::unique_ptr<reactor>> reactors_;
+    std::atomic<bool> stopping_{false};
+};
+
+} // namespace coro_ext
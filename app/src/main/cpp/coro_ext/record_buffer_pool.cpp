@@ -0,0 +1,66 @@
+// All code comments are in English per repo policy.
+
+#include "record_buffer_pool.hpp"
+
+#include <utility>
+
+namespace coro_ext {
+
+record_buffer_pool::buffer::buffer(buffer &&other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr)), data_(std::move(other.data_)), size_(std::exchange(other.size_, 0)) {}
+
+record_buffer_pool::buffer &record_buffer_pool::buffer::operator=(buffer &&other) noexcept {
+    if (this != &other) {
+        release();
+        pool_ = std::exchange(other.pool_, nullptr);
+        data_ = std::move(other.data_);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+record_buffer_pool::buffer::~buffer() {
+    release();
+}
+
+void record_buffer_pool::buffer::release() noexcept {
+    if (pool_ && data_) pool_->give_back(std::move(data_));
+    pool_ = nullptr;
+    size_ = 0;
+}
+
+record_buffer_pool::record_buffer_pool(options opts) : opts_(opts) {
+    free_.reserve(opts_.max_cached);
+}
+
+record_buffer_pool::buffer record_buffer_pool::acquire() {
+    std::unique_ptr<char[]> data;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (!free_.empty()) {
+            data = std::move(free_.back());
+            free_.pop_back();
+        }
+    }
+    // Default-initialized: no zeroing of a buffer that is about to be overwritten.
+    if (!data) data = std::unique_ptr<char[]>(new char[opts_.buffer_size]);
+    return buffer{this, std::move(data), opts_.buffer_size};
+}
+
+void record_buffer_pool::give_back(std::unique_ptr<char[]> data) noexcept {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (free_.size() < opts_.max_cached) {
+            free_.push_back(std::move(data));
+            return;
+        }
+    }
+    // Pool is full: data is freed here, outside the lock.
+}
+
+std::size_t record_buffer_pool::cached() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return free_.size();
+}
+
+} // namespace coro_ext
@@ -0,0 +1,71 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace coro_ext {
+
+// Pool of fixed-size I/O buffers sized for one TLS record, so connection churn reuses the same memory instead of
+// allocating (and faulting in) fresh read/write buffers per connection. net::tls::client::recv()/send() take
+// caller-provided spans: lease one buffer per connection and pass span() (or a prefix of it) to them. Buffers are
+// handed out as move-only leases that return themselves to the pool; the pool must outlive every lease.
+class record_buffer_pool {
+public:
+    // Largest TLS ciphertext record: 5-byte header + 2^14 plaintext + 2048 bytes of expansion (RFC 5246 6.2.3).
+    static constexpr std::size_t max_record_size = 5 + 16384 + 2048;
+
+    struct options {
+        std::size_t buffer_size = max_record_size;
+        // Idle buffers kept for reuse; extra buffers are freed when released.
+        std::size_t max_cached = 64;
+    };
+
+    class buffer {
+    public:
+        buffer() noexcept = default;
+        buffer(buffer &&other) noexcept;
+        buffer &operator=(buffer &&other) noexcept;
+        buffer(const buffer &) = delete;
+        buffer &operator=(const buffer &) = delete;
+        ~buffer();
+
+        char *data() const noexcept { return data_.get(); }
+        std::size_t size() const noexcept { return size_; }
+        std::span<char> span() const noexcept { return {data_.get(), size_}; }
+        explicit operator bool() const noexcept { return data_ != nullptr; }
+
+    private:
+        friend class record_buffer_pool;
+        buffer(record_buffer_pool *pool, std::unique_ptr<char[]> data, std::size_t size) noexcept
+            : pool_(pool), data_(std::move(data)), size_(size) {}
+        void release() noexcept;
+
+        record_buffer_pool *pool_ = nullptr;
+        std::unique_ptr<char[]> data_;
+        std::size_t size_ = 0;
+    };
+
+    record_buffer_pool() : record_buffer_pool(options{}) {}
+    explicit record_buffer_pool(options opts);
+    record_buffer_pool(const record_buffer_pool &) = delete;
+    record_buffer_pool &operator=(const record_buffer_pool &) = delete;
+
+    // Reuses an idle buffer when available, otherwise allocates one. Contents are unspecified.
+    buffer acquire();
+
+    std::size_t buffer_size() const noexcept { return opts_.buffer_size; }
+    std::size_t cached() const;
+
+private:
+    void give_back(std::unique_ptr<char[]> data) noexcept;
+
+    options opts_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<char[]>> free_;
+};
+
+} // namespace coro_ext
@@ -0,0 +1,234 @@
+// All code comments are in English per repo policy.
+
+#include "timer_wheel.hpp"
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+namespace coro_ext {
+
+namespace {
+
+constexpr std::uint64_t kSlotMask = timer_wheel::slots_per_level - 1;
+// Longest representable timeout, in ticks from the current tick.
+constexpr std::uint64_t kMaxDelta = (std::uint64_t{1} << (timer_wheel::slot_bits * timer_wheel::level_count)) - 1;
+constexpr std::uint64_t kNoEvent = std::numeric_limits<std::uint64_t>::max();
+
+constexpr std::size_t level_shift(std::size_t level) noexcept {
+    return level * timer_wheel::slot_bits;
+}
+
+// First occupied slot at or after `from`, or slots_per_level when there is none.
+std::size_t find_occupied(const std::array<std::uint64_t, timer_wheel::slots_per_level / 64> &occupied,
+                          std::size_t from) noexcept {
+    for (std::size_t word = from / 64; word < occupied.size(); ++word) {
+        std::uint64_t bits = occupied[word];
+        if (word == from / 64) bits &= ~std::uint64_t{0} << (from % 64);
+        if (bits) return word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+    }
+    return timer_wheel::slots_per_level;
+}
+
+} // namespace
+
+void timer_wheel::timer::cancel() noexcept {
+    if (wheel_) wheel_->unlink(*this);
+}
+
+void timer_wheel::sleep_operation::await_suspend(std::coroutine_handle<> handle) noexcept {
+    timer_.waiter_ = handle;
+    wheel_.arm(timer_, duration_);
+}
+
+timer_wheel::timer_wheel(options opts)
+    : opts_(opts), timer_fd_(::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+      start_(std::chrono::steady_clock::now()) {
+    if (timer_fd_ < 0) throw std::system_error(errno, std::generic_category(), "timerfd_create");
+    if (opts_.tick <= std::chrono::microseconds::zero()) opts_.tick = std::chrono::microseconds{1};
+}
+
+timer_wheel::~timer_wheel() {
+    // Detach whatever is still armed so those timers' destructors do not touch the wheel.
+    for (auto &l : levels_) {
+        for (timer *head : l.heads) {
+            for (timer *t = head; t;) {
+                timer *next = t->next_;
+                t->wheel_ = nullptr;
+                t->prev_ = t->next_ = nullptr;
+                t = next;
+            }
+        }
+    }
+    ::close(timer_fd_);
+}
+
+std::uint64_t timer_wheel::ticks_at(std::chrono::steady_clock::time_point tp, bool round_up) const noexcept {
+    if (tp <= start_) return 0;
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(tp - start_).count();
+    const auto tick = std::chrono::duration_cast<std::chrono::nanoseconds>(opts_.tick).count();
+    return static_cast<std::uint64_t>(round_up ? (elapsed + tick - 1) / tick : elapsed / tick);
+}
+
+void timer_wheel::arm(timer &t, std::chrono::nanoseconds timeout) noexcept {
+    if (stopping_) return;
+    if (t.wheel_) unlink(t);
+    const auto now = std::chrono::steady_clock::now();
+    // now_ only moves when run() wakes up, so after an idle period it lags the clock. With nothing armed there is
+    // nothing to process in between: catch up, so the timer is placed (and clamped) relative to the current tick.
+    if (count_ == 0 && !advancing_) now_ = std::max(now_, ticks_at(now, false));
+    const std::uint64_t due = ticks_at(now + timeout, true);
+    t.expiry_ = std::clamp(due, now_ + 1, now_ + kMaxDelta);
+    t.wheel_ = this;
+    place(t);
+    ++count_;
+    if (!advancing_ && (programmed_ == 0 || t.expiry_ < programmed_)) program(t.expiry_);
+}
+
+void timer_wheel::place(timer &t) noexcept {
+    const std::uint64_t delta = t.expiry_ - now_;
+    std::size_t lvl = 0;
+    while (lvl + 1 < level_count && delta >= (std::uint64_t{1} << level_shift(lvl + 1))) ++lvl;
+    const auto slot = static_cast<std::size_t>((t.expiry_ >> level_shift(lvl)) & kSlotMask);
+    level &l = levels_[lvl];
+    t.level_ = static_cast<std::uint16_t>(lvl);
+    t.slot_ = static_cast<std::uint16_t>(slot);
+    t.prev_ = nullptr;
+    t.next_ = l.heads[slot];
+    if (t.next_) t.next_->prev_ = &t;
+    l.heads[slot] = &t;
+    l.occupied[slot / 64] |= std::uint64_t{1} << (slot % 64);
+}
+
+void timer_wheel::unlink(timer &t) noexcept {
+    level &l = levels_[t.level_];
+    if (t.prev_) {
+        t.prev_->next_ = t.next_;
+    } else {
+        l.heads[t.slot_] = t.next_;
+        if (!t.next_) l.occupied[t.slot_ / 64] &= ~(std::uint64_t{1} << (t.slot_ % 64));
+    }
+    if (t.next_) t.next_->prev_ = t.prev_;
+    t.prev_ = t.next_ = nullptr;
+    t.wheel_ = nullptr;
+    --count_;
+}
+
+// Earliest tick after now_ at which something has to happen: a level-0 slot fires, or a higher-level slot is
+// cascaded down. Slots are scanned circularly starting after the current index; a timer in the current index of a
+// higher level belongs to the next rotation of that level.
+std::uint64_t timer_wheel::next_event_tick() const noexcept {
+    std::uint64_t best = kNoEvent;
+    for (std::size_t lvl = 0; lvl < level_count; ++lvl) {
+        const level &l = levels_[lvl];
+        const std::uint64_t base = now_ >> level_shift(lvl);
+        const auto index = static_cast<std::size_t>(base & kSlotMask);
+        std::size_t offset = 0;
+        if (const std::size_t found = find_occupied(l.occupied, index + 1); found < slots_per_level) {
+            offset = found - index;
+        } else if (const std::size_t wrapped = find_occupied(l.occupied, 0); wrapped <= index) {
+            offset = wrapped + slots_per_level - index;
+        }
+        if (offset > 0) best = std::min(best, (base + offset) << level_shift(lvl));
+    }
+    return best;
+}
+
+// Moves timers from the higher-level slots that start at now_ down to where they now belong.
+void timer_wheel::cascade() noexcept {
+    for (std::size_t lvl = 1; lvl < level_count; ++lvl) {
+        if (((now_ >> level_shift(lvl - 1)) & kSlotMask) != 0) break;
+        const auto slot = static_cast<std::size_t>((now_ >> level_shift(lvl)) & kSlotMask);
+        level &l = levels_[lvl];
+        timer *t = std::exchange(l.heads[slot], nullptr);
+        l.occupied[slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+        while (t) {
+            timer *next = t->next_;
+            place(*t);
+            t = next;
+        }
+    }
+}
+
+void timer_wheel::fire(timer &t) {
+    unlink(t);
+    if (t.waiter_) {
+        std::exchange(t.waiter_, nullptr).resume();
+    } else if (t.callback_) {
+        t.callback_();
+    }
+}
+
+void timer_wheel::advance_to(std::uint64_t target) {
+    advancing_ = true;
+    while (now_ < target) {
+        const std::uint64_t next = count_ > 0 ? next_event_tick() : kNoEvent;
+        if (next > target) {
+            now_ = target;
+            break;
+        }
+        now_ = next;
+        cascade();
+        // Everything in the current level-0 slot is due now. Timers armed by callbacks land in later slots.
+        level &l0 = levels_[0];
+        const auto slot = static_cast<std::size_t>(now_ & kSlotMask);
+        while (timer *t = l0.heads[slot]) fire(*t);
+    }
+    advancing_ = false;
+}
+
+void timer_wheel::fire_all() {
+    for (auto &l : levels_) {
+        for (timer *&head : l.heads) {
+            while (head) fire(*head);
+        }
+    }
+}
+
+void timer_wheel::program(std::uint64_t tick) noexcept {
+    itimerspec spec{};
+    if (tick != 0) {
+        const auto deadline = start_ + opts_.tick * static_cast<std::int64_t>(tick);
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        spec.it_value.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    }
+    // steady_clock is CLOCK_MONOTONIC, so the deadline can be handed over as an absolute time.
+    ::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+    programmed_ = tick;
+}
+
+coro::task<void> timer_wheel::run(std::shared_ptr<coro::io_scheduler> scheduler) {
+    co_await scheduler->schedule();
+    while (!stopping_) {
+        const auto status = co_await scheduler->poll(timer_fd_, coro::poll_op::read);
+        if (status == coro::poll_status::error || status == coro::poll_status::closed) break;
+        std::uint64_t expirations = 0;
+        [[maybe_unused]] const auto n = ::read(timer_fd_, &expirations, sizeof(expirations));
+        programmed_ = 0;
+        if (stopping_) break;
+        advance_to(ticks_at(std::chrono::steady_clock::now(), false));
+        if (count_ > 0) program(next_event_tick());
+    }
+    stopping_ = true;
+    program(0);
+    fire_all();
+    co_return;
+}
+
+void timer_wheel::shutdown() {
+    if (stopping_) return;
+    stopping_ = true;
+    // Any absolute time in the past expires immediately and wakes run().
+    itimerspec spec{};
+    spec.it_value.tv_nsec = 1;
+    ::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+} // namespace coro_ext
@@ -0,0 +1,140 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <coro/coro.hpp>
+
+#include <array>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace coro_ext {
+
+// Hierarchical timing wheel (Varghese & Lauck) for large numbers of timers that are mostly cancelled before they
+// expire, such as a read timeout per connection. Arming and cancelling a timer are O(1) list operations with no
+// allocation, instead of the ordered-tree insert/erase behind coro::io_scheduler::schedule_after()/yield_for() and
+// poll timeouts.
+//
+// Time is counted in ticks of options::tick. Four levels of 256 slots cover 2^32 ticks (~49 days at 1 ms); longer
+// timeouts are clamped. Timers due in the next 256 ticks sit in level 0; later ones sit in coarser levels and are
+// cascaded down as the wheel turns. Timers fire at the first tick boundary at or after their deadline, so the
+// resolution (and worst-case lateness) is one tick.
+//
+// The wheel owns a timerfd that run() polls through a coro::io_scheduler. The timerfd is programmed with the next
+// occupied slot (or cascade boundary), and only re-programmed when a newly armed timer is due earlier than that, so
+// steady re-arming costs no syscalls. cancel() never touches the timerfd either: if the timer it was programmed for
+// is cancelled, run() still wakes up once at that tick, finds nothing due and programs the next pending slot (or
+// leaves the timerfd disarmed when the wheel is empty). An empty wheel costs no wake-ups.
+//
+// Not thread safe: arm(), cancel(), sleep_for() and run() must all execute on the same thread, e.g. an io_scheduler
+// using execution_strategy_t::process_tasks_inline. Callbacks run inline on that thread.
+class timer_wheel {
+public:
+    static constexpr std::size_t level_count = 4;
+    static constexpr std::size_t slot_bits = 8;
+    static constexpr std::size_t slots_per_level = std::size_t{1} << slot_bits;
+
+    struct options {
+        // Tick resolution; timers are rounded up to whole ticks.
+        std::chrono::microseconds tick{std::chrono::milliseconds{1}};
+    };
+
+    // Intrusive timer: embed one per connection (or per pending operation) and re-arm it as needed; the destructor
+    // cancels it. A callback may re-arm or cancel any timer, including its own, but must not destroy its own timer.
+    class timer {
+    public:
+        timer() = default;
+        explicit timer(std::function<void()> callback) : callback_(std::move(callback)) {}
+        timer(const timer &) = delete;
+        timer &operator=(const timer &) = delete;
+        ~timer() { cancel(); }
+
+        void set_callback(std::function<void()> callback) { callback_ = std::move(callback); }
+        bool armed() const noexcept { return wheel_ != nullptr; }
+        // Disarms the timer if it is armed; O(1).
+        void cancel() noexcept;
+
+    private:
+        friend class timer_wheel;
+
+        std::function<void()> callback_;
+        std::coroutine_handle<> waiter_; // set by sleep_for() instead of a callback
+        timer_wheel *wheel_ = nullptr;
+        timer *prev_ = nullptr;
+        timer *next_ = nullptr;
+        std::uint64_t expiry_ = 0; // in ticks since the wheel started
+        std::uint16_t level_ = 0;
+        std::uint16_t slot_ = 0;
+    };
+
+    class sleep_operation {
+    public:
+        // Does not suspend once the wheel is shutting down.
+        bool await_ready() const noexcept { return wheel_.stopping_; }
+        void await_suspend(std::coroutine_handle<> handle) noexcept;
+        void await_resume() const noexcept {}
+
+    private:
+        friend class timer_wheel;
+        sleep_operation(timer_wheel &wheel, std::chrono::nanoseconds duration) noexcept
+            : wheel_(wheel), duration_(duration) {}
+
+        timer_wheel &wheel_;
+        std::chrono::nanoseconds duration_;
+        timer timer_;
+    };
+
+    timer_wheel() : timer_wheel(options{}) {}
+    // Throws std::system_error when the timerfd cannot be created.
+    explicit timer_wheel(options opts);
+    timer_wheel(const timer_wheel &) = delete;
+    timer_wheel &operator=(const timer_wheel &) = delete;
+    ~timer_wheel();
+
+    // (Re-)arms `t` to fire after `timeout`. Re-arming an armed timer moves it; O(1). Ignored after shutdown().
+    void arm(timer &t, std::chrono::nanoseconds timeout) noexcept;
+    // Suspends the calling coroutine for at least `duration` (rounded up to the tick).
+    [[nodiscard]] sleep_operation sleep_for(std::chrono::nanoseconds duration) noexcept {
+        return sleep_operation{*this, duration};
+    }
+
+    // Drives the wheel: waits on the timerfd through `scheduler` and fires due timers until shutdown(). Timers still
+    // armed at shutdown fire once on the way out, so no sleeping coroutine is left suspended.
+    coro::task<void> run(std::shared_ptr<coro::io_scheduler> scheduler);
+    // Makes run() return at its next wake-up (immediately if it is waiting). Call it from the wheel's thread.
+    void shutdown();
+
+    std::size_t size() const noexcept { return count_; }
+    std::chrono::microseconds tick() const noexcept { return opts_.tick; }
+
+private:
+    struct level {
+        std::array<timer *, slots_per_level> heads{};
+        std::array<std::uint64_t, slots_per_level / 64> occupied{};
+    };
+
+    std::uint64_t ticks_at(std::chrono::steady_clock::time_point tp, bool round_up) const noexcept;
+    void place(timer &t) noexcept;
+    void unlink(timer &t) noexcept;
+    std::uint64_t next_event_tick() const noexcept;
+    void advance_to(std::uint64_t target);
+    void cascade() noexcept;
+    void fire(timer &t);
+    void fire_all();
+    void program(std::uint64_t tick) noexcept;
+
+    options opts_;
+    int timer_fd_ = -1;
+    std::chrono::steady_clock::time_point start_;
+    std::array<level, level_count> levels_{};
+    std::uint64_t now_ = 0;        // last processed tick
+    std::uint64_t programmed_ = 0; // tick the timerfd is set for, 0 when disarmed
+    std::size_t count_ = 0;
+    bool advancing_ = false; // run() reprograms the timerfd once it has processed due ticks
+    bool stopping_ = false;
+};
+
+} // namespace coro_ext
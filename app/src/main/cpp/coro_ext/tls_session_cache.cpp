@@ -0,0 +1,259 @@
+// All code comments are in English per repo policy.
+
+#include "tls_session_cache.hpp"
+
+#include <coro/coro.hpp>
+#include <openssl/ssl.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <ctime>
+#include <vector>
+
+namespace coro_ext {
+
+namespace {
+
+// ex_data slots: the owning cache on SSL_CTX, the peer key (heap std::string) on SSL.
+int g_ctx_index = -1;
+int g_ssl_index = -1;
+std::once_flag g_index_once;
+
+void free_peer_key(void *, void *ptr, CRYPTO_EX_DATA *, int, long, void *) {
+    delete static_cast<std::string *>(ptr);
+}
+
+void init_indices() {
+    std::call_once(g_index_once, [] {
+        g_ctx_index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+        g_ssl_index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, free_peer_key);
+    });
+}
+
+void set_peer_key(SSL *ssl, std::string_view peer) {
+    delete static_cast<std::string *>(SSL_get_ex_data(ssl, g_ssl_index));
+    SSL_set_ex_data(ssl, g_ssl_index, new std::string(peer));
+}
+
+bool usable(SSL_SESSION *session) {
+    if (!SSL_SESSION_is_resumable(session)) return false;
+    const long long expires =
+        static_cast<long long>(SSL_SESSION_get_time(session)) + static_cast<long long>(SSL_SESSION_get_timeout(session));
+    return expires > static_cast<long long>(std::time(nullptr));
+}
+
+bool single_use(SSL_SESSION *session) {
+    return SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION;
+}
+
+// Key for a connection that was not tagged by prepare(): "sni:port" when SNI is set, else the peer "ip:port"
+// ("[ip]:port" for IPv6). Without a socket (memory BIOs) the SNI host alone is used. Empty when nothing identifies
+// the peer, in which case the connection is not cached.
+std::string derive_peer_key(const SSL *ssl) {
+    std::string key;
+    if (const char *host = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name)) key = host;
+    const int fd = SSL_get_fd(ssl);
+    sockaddr_storage addr{};
+    socklen_t addr_len = sizeof(addr);
+    if (fd < 0 || ::getpeername(fd, reinterpret_cast<sockaddr *>(&addr), &addr_len) != 0) return key;
+
+    char ip[INET6_ADDRSTRLEN] = {};
+    std::uint16_t port = 0;
+    if (addr.ss_family == AF_INET) {
+        const auto *in = reinterpret_cast<const sockaddr_in *>(&addr);
+        ::inet_ntop(AF_INET, &in->sin_addr, ip, sizeof(ip));
+        port = ntohs(in->sin_port);
+    } else if (addr.ss_family == AF_INET6) {
+        const auto *in6 = reinterpret_cast<const sockaddr_in6 *>(&addr);
+        ::inet_ntop(AF_INET6, &in6->sin6_addr, ip, sizeof(ip));
+        port = ntohs(in6->sin6_port);
+    } else {
+        return key;
+    }
+    if (key.empty()) key = addr.ss_family == AF_INET6 ? "[" + std::string(ip) + "]" : std::string(ip);
+    return key + ":" + std::to_string(port);
+}
+
+// tls::context declares native_handle() private with tls::client and tls::server as friends. Access checks do not
+// apply to the template arguments of an explicit instantiation ([temp.spec.general]), so instantiating
+// context_access with that member defines a friend function that can call it.
+using context_handle_fn = SSL_CTX *(coro::net::tls::context::*)();
+
+template <context_handle_fn Handle>
+struct context_access {
+    friend SSL_CTX *context_handle(coro::net::tls::context &ctx) { return (ctx.*Handle)(); }
+};
+
+SSL_CTX *context_handle(coro::net::tls::context &ctx);
+
+template struct context_access<&coro::net::tls::context::native_handle>;
+
+} // namespace
+
+SSL_CTX *native_handle(coro::net::tls::context &ctx) {
+    return context_handle(ctx);
+}
+
+tls_session_cache::tls_session_cache(options opts) : opts_(opts) {
+    if (opts_.capacity == 0) opts_.capacity = 1;
+    if (opts_.tickets_per_peer == 0) opts_.tickets_per_peer = 1;
+    init_indices();
+}
+
+tls_session_cache::~tls_session_cache() {
+    clear();
+}
+
+void tls_session_cache::attach(SSL_CTX *ctx) {
+    SSL_CTX_set_ex_data(ctx, g_ctx_index, this);
+    // Client-side caching only; OpenSSL's internal client cache is bypassed so this cache is the single owner.
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, &tls_session_cache::on_new_session);
+    SSL_CTX_set_info_callback(ctx, &tls_session_cache::on_info);
+}
+
+void tls_session_cache::attach(coro::net::tls::context &ctx) {
+    attach(native_handle(ctx));
+}
+
+bool tls_session_cache::prepare(SSL *ssl, std::string_view peer) {
+    set_peer_key(ssl, peer);
+    return offer(ssl, std::string(peer));
+}
+
+void tls_session_cache::on_info(const SSL *ssl, int where, int) {
+    // Runs before the ClientHello is built, so a session set here is offered in it. Connections tagged by prepare()
+    // and renegotiations (which already have a session) are left alone.
+    if (!(where & SSL_CB_HANDSHAKE_START) || SSL_is_server(ssl)) return;
+    if (SSL_get_ex_data(ssl, g_ssl_index) || SSL_get_session(ssl)) return;
+    auto *cache = static_cast<tls_session_cache *>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), g_ctx_index));
+    if (!cache) return;
+    std::string peer = derive_peer_key(ssl);
+    if (peer.empty()) return;
+    // OpenSSL passes the SSL as const, but the callback runs inside SSL_connect() on the connection's own thread.
+    auto *mutable_ssl = const_cast<SSL *>(ssl);
+    set_peer_key(mutable_ssl, peer);
+    cache->offer(mutable_ssl, peer);
+}
+
+bool tls_session_cache::offer(SSL *ssl, const std::string &peer) {
+    SSL_SESSION *session = nullptr;
+    std::vector<SSL_SESSION *> expired;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto it = sessions_.find(peer);
+        if (it != sessions_.end()) {
+            auto &sessions = it->second.sessions;
+            // Newest first; expired sessions found on the way are dropped.
+            while (!sessions.empty() && !session) {
+                SSL_SESSION *candidate = sessions.back();
+                sessions.pop_back();
+                if (!usable(candidate)) {
+                    expired.push_back(candidate);
+                } else if (single_use(candidate)) {
+                    session = candidate; // the cache's reference moves to this connection
+                } else {
+                    sessions.push_back(candidate);
+                    SSL_SESSION_up_ref(candidate);
+                    session = candidate;
+                }
+            }
+            if (sessions.empty()) {
+                lru_.erase(it->second.lru);
+                sessions_.erase(it);
+            } else {
+                lru_.splice(lru_.begin(), lru_, it->second.lru);
+            }
+        }
+        ++(session ? stats_.hits : stats_.misses);
+    }
+    // Freed outside the lock.
+    for (SSL_SESSION *s : expired) SSL_SESSION_free(s);
+    if (!session) return false;
+    const bool ok = SSL_set_session(ssl, session) == 1;
+    SSL_SESSION_free(session); // SSL_set_session took its own reference
+    return ok;
+}
+
+int tls_session_cache::on_new_session(SSL *ssl, SSL_SESSION *session) {
+    auto *cache = static_cast<tls_session_cache *>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), g_ctx_index));
+    const auto *peer = static_cast<const std::string *>(SSL_get_ex_data(ssl, g_ssl_index));
+    if (!cache || !peer) return 0; // no peer key: let OpenSSL drop the reference
+    cache->store(*peer, session);
+    return 1; // we keep the reference OpenSSL handed over
+}
+
+void tls_session_cache::store(const std::string &peer, SSL_SESSION *session) {
+    std::vector<SSL_SESSION *> dropped;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        ++stats_.stored;
+        auto it = sessions_.find(peer);
+        if (it == sessions_.end()) {
+            lru_.push_front(peer);
+            it = sessions_.emplace(peer, entry{{}, lru_.begin()}).first;
+        } else {
+            lru_.splice(lru_.begin(), lru_, it->second.lru);
+        }
+        auto &sessions = it->second.sessions;
+        // A TLS 1.2 session supersedes whatever was cached; TLS 1.3 servers send several tickets per connection, and
+        // those accumulate up to tickets_per_peer.
+        const std::size_t keep = single_use(session) ? opts_.tickets_per_peer : 1;
+        if (!single_use(session) || (!sessions.empty() && !single_use(sessions.back()))) {
+            dropped.assign(sessions.begin(), sessions.end());
+            sessions.clear();
+        }
+        sessions.push_back(session);
+        while (sessions.size() > keep) {
+            dropped.push_back(sessions.front());
+            sessions.pop_front();
+        }
+        if (sessions_.size() > opts_.capacity) {
+            auto victim = sessions_.find(lru_.back());
+            dropped.insert(dropped.end(), victim->second.sessions.begin(), victim->second.sessions.end());
+            sessions_.erase(victim);
+            lru_.pop_back();
+        }
+    }
+    // Freed outside the lock.
+    for (SSL_SESSION *s : dropped) SSL_SESSION_free(s);
+}
+
+void tls_session_cache::remove(std::string_view peer) {
+    std::deque<SSL_SESSION *> sessions;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto it = sessions_.find(std::string(peer));
+        if (it == sessions_.end()) return;
+        sessions.swap(it->second.sessions);
+        lru_.erase(it->second.lru);
+        sessions_.erase(it);
+    }
+    for (SSL_SESSION *s : sessions) SSL_SESSION_free(s);
+}
+
+void tls_session_cache::clear() {
+    std::unordered_map<std::string, entry> sessions;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        sessions.swap(sessions_);
+        lru_.clear();
+    }
+    for (auto &[peer, e] : sessions) {
+        for (SSL_SESSION *s : e.sessions) SSL_SESSION_free(s);
+    }
+}
+
+std::size_t tls_session_cache::size() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return sessions_.size();
+}
+
+tls_session_cache::stats tls_session_cache::statistics() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return stats_;
+}
+
+} // namespace coro_ext
@@ -0,0 +1,96 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+typedef struct ssl_st SSL;
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_session_st SSL_SESSION;
+
+namespace coro::net::tls {
+class context;
+} // namespace coro::net::tls
+
+namespace coro_ext {
+
+// Thread-safe client-side TLS session cache keyed by peer, shared by every connection made from the SSL_CTXs it is
+// attached to. Reconnecting to a known peer offers a cached session (TLS 1.2 session ID/ticket, TLS 1.3 PSK ticket),
+// turning a full handshake into an abbreviated one.
+//
+// attach(ctx) is the only required step: when a client handshake starts on an SSL made from ctx, the cache derives the
+// peer key from the SNI host name and the socket's peer address and offers the session cached for it. For
+// net::tls::client, attach the cache to the shared tls::context the clients are built from; every client made from it
+// then resumes without further calls. Code that owns the SSL can call prepare(ssl, peer) before SSL_connect() to use
+// its own key instead. Sessions are stored from OpenSSL's new-session callback, so TLS 1.3 tickets that arrive after
+// the handshake are picked up too.
+//
+// TLS 1.3 tickets are single-use (RFC 8446 C.4): a ticket is removed from the cache when it is offered, and up to
+// `tickets_per_peer` of the tickets a server sends are kept for concurrent reconnects. A TLS 1.2 session is offered
+// until it expires or a newer one replaces it. Least recently used peers are evicted beyond `capacity`; expired or
+// non-resumable sessions are never offered.
+class tls_session_cache {
+public:
+    struct options {
+        // Maximum number of peers with a cached session.
+        std::size_t capacity = 256;
+        // TLS 1.3 tickets kept per peer; older tickets are dropped first.
+        std::size_t tickets_per_peer = 4;
+    };
+
+    struct stats {
+        std::uint64_t hits = 0;   // prepare() offered a cached session
+        std::uint64_t misses = 0; // prepare() found nothing usable
+        std::uint64_t stored = 0; // sessions received from OpenSSL
+    };
+
+    tls_session_cache() : tls_session_cache(options{}) {}
+    explicit tls_session_cache(options opts);
+    tls_session_cache(const tls_session_cache &) = delete;
+    tls_session_cache &operator=(const tls_session_cache &) = delete;
+    ~tls_session_cache();
+
+    // Enables client session caching on ctx, routes its new sessions here and offers cached sessions when client
+    // handshakes start. Installs ctx's new-session and info callbacks. The cache must outlive ctx.
+    void attach(SSL_CTX *ctx);
+    // Same, for the SSL_CTX behind a libcoro TLS context (see native_handle()).
+    void attach(coro::net::tls::context &ctx);
+    // Tags ssl with `peer` and offers a cached session for it, if any. Returns true when a session was set.
+    bool prepare(SSL *ssl, std::string_view peer);
+    // Drops the sessions cached for `peer` (e.g. after the server rejected them or the peer changed identity).
+    void remove(std::string_view peer);
+    void clear();
+
+    std::size_t size() const;
+    stats statistics() const;
+
+private:
+    struct entry {
+        // Oldest first. Holds one TLS 1.2 session, or up to tickets_per_peer TLS 1.3 tickets.
+        std::deque<SSL_SESSION *> sessions;
+        std::list<std::string>::iterator lru;
+    };
+
+    static int on_new_session(SSL *ssl, SSL_SESSION *session);
+    static void on_info(const SSL *ssl, int where, int ret);
+    bool offer(SSL *ssl, const std::string &peer);
+    void store(const std::string &peer, SSL_SESSION *session);
+
+    options opts_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, entry> sessions_;
+    std::list<std::string> lru_; // front = most recently used
+    stats stats_;
+};
+
+// The SSL_CTX owned by a libcoro TLS context. tls::context only lets tls::client and tls::server reach it, so this is
+// how app code configures it (session cache, ticket count, statistics). The context keeps ownership.
+SSL_CTX *native_handle(coro::net::tls::context &ctx);
+
+} // namespace coro_ext
@@ -0,0 +1,127 @@
+// All code comments are in English per repo policy.
+
+#include "udp_batch.hpp"
+
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+// Older libc headers lack the UDP offload socket options (values from linux/udp.h).
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+namespace coro_ext {
+
+// Room for one UDP_SEGMENT (send, uint16_t) or UDP_GRO (receive, int) control message per datagram.
+struct udp_batch::control_buffer {
+    alignas(cmsghdr) unsigned char data[CMSG_SPACE(sizeof(int))];
+};
+
+namespace {
+
+bool would_block(int err) noexcept {
+    return err == EAGAIN || err == EWOULDBLOCK;
+}
+
+} // namespace
+
+bool udp_batch::gso_supported() noexcept {
+    static const bool supported = [] {
+        const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return false;
+        const int segment = 1200;
+        const bool ok = ::setsockopt(fd, SOL_UDP, UDP_SEGMENT, &segment, sizeof(segment)) == 0;
+        ::close(fd);
+        return ok;
+    }();
+    return supported;
+}
+
+bool udp_batch::enable_gro(int fd) noexcept {
+    const int one = 1;
+    return ::setsockopt(fd, SOL_UDP, UDP_GRO, &one, sizeof(one)) == 0;
+}
+
+udp_batch::udp_batch(options opts) : opts_(opts) {
+    opts_.max_batch = std::max<std::size_t>(opts_.max_batch, 1);
+    headers_.reset(new mmsghdr[opts_.max_batch]);
+    iovecs_.reset(new iovec[opts_.max_batch]);
+    controls_.reset(new control_buffer[opts_.max_batch]);
+}
+
+udp_batch::~udp_batch() = default;
+
+int udp_batch::recv(int fd, std::span<datagram> out) noexcept {
+    const std::size_t count = std::min(out.size(), opts_.max_batch);
+    if (count == 0) return 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        iovecs_[i] = iovec{out[i].data.data(), out[i].data.size()};
+        msghdr &msg = headers_[i].msg_hdr;
+        msg = msghdr{};
+        msg.msg_name = &out[i].address;
+        msg.msg_namelen = sizeof(out[i].address);
+        msg.msg_iov = &iovecs_[i];
+        msg.msg_iovlen = 1;
+        msg.msg_control = controls_[i].data;
+        msg.msg_controllen = sizeof(controls_[i].data);
+        headers_[i].msg_len = 0;
+    }
+    const int received = ::recvmmsg(fd, headers_.get(), static_cast<unsigned int>(count), MSG_DONTWAIT, nullptr);
+    if (received < 0) return would_block(errno) ? 0 : -errno;
+    for (int i = 0; i < received; ++i) {
+        msghdr &msg = headers_[i].msg_hdr;
+        datagram &d = out[i];
+        d.size = headers_[i].msg_len;
+        d.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+        d.address_size = msg.msg_namelen;
+        d.segment_size = 0;
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                int segment = 0;
+                std::memcpy(&segment, CMSG_DATA(cmsg), sizeof(segment));
+                d.segment_size = static_cast<std::uint16_t>(segment);
+            }
+        }
+    }
+    return received;
+}
+
+int udp_batch::send(int fd, std::span<const datagram> in) noexcept {
+    const std::size_t count = std::min(in.size(), opts_.max_batch);
+    if (count == 0) return 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const datagram &d = in[i];
+        iovecs_[i] = iovec{d.data.data(), d.data.size()};
+        msghdr &msg = headers_[i].msg_hdr;
+        msg = msghdr{};
+        if (d.address_size > 0) {
+            msg.msg_name = const_cast<sockaddr_storage *>(&d.address);
+            msg.msg_namelen = d.address_size;
+        }
+        msg.msg_iov = &iovecs_[i];
+        msg.msg_iovlen = 1;
+        if (d.segment_size > 0) {
+            msg.msg_control = controls_[i].data;
+            msg.msg_controllen = CMSG_SPACE(sizeof(std::uint16_t));
+            cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+            std::memcpy(CMSG_DATA(cmsg), &d.segment_size, sizeof(d.segment_size));
+        }
+        headers_[i].msg_len = 0;
+    }
+    const int sent = ::sendmmsg(fd, headers_.get(), static_cast<unsigned int>(count), MSG_DONTWAIT);
+    if (sent < 0) return would_block(errno) ? 0 : -errno;
+    return sent;
+}
+
+} // namespace coro_ext
@@ -0,0 +1,76 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace coro_ext {
+
+// Batched datagram I/O for non-blocking UDP sockets (for example the native handle of a coro::net::udp::peer socket):
+// one recvmmsg/sendmmsg moves a whole span of datagrams instead of one recvfrom/sendto per packet. Like udp::peer,
+// the calls never block; wait for readiness with coro::io_scheduler::poll() and call again. A single poll +
+// recv() then drains up to max_batch datagrams, so both syscalls and scheduler round-trips are paid per batch.
+//
+// Optional UDP segmentation offload (Linux >= 4.18 for GSO, >= 5.0 for GRO): a send datagram with segment_size set
+// is split by the kernel into segment_size-byte packets, and with GRO enabled the kernel may hand several received
+// packets from one sender over as a single coalesced datagram whose segment_size reports the original packet size.
+//
+// The object only holds the mmsghdr/iovec/cmsg scratch arrays; it is not thread safe, use one per receiving or
+// sending coroutine.
+class udp_batch {
+public:
+    struct options {
+        // Largest number of datagrams moved per call; only the first max_batch entries of a longer span are used.
+        std::size_t max_batch = 64;
+    };
+
+    struct datagram {
+        // Send: the payload. Receive: the buffer to fill.
+        std::span<char> data;
+        // Receive: bytes stored in data.
+        std::size_t size = 0;
+        // Receive: the datagram was larger than data.size(); the kernel discarded the bytes past size.
+        bool truncated = false;
+        // Send: destination, ignored when address_size is 0 (connected socket). Receive: source address.
+        sockaddr_storage address{};
+        socklen_t address_size = 0;
+        // Send: GSO segment size, 0 to send data as one datagram. Receive: GRO segment size of a coalesced datagram,
+        // 0 when the datagram was not coalesced.
+        std::uint16_t segment_size = 0;
+    };
+
+    // True when the kernel accepts UDP_SEGMENT on this kind of socket (probed once with a temporary socket).
+    static bool gso_supported() noexcept;
+    // Enables UDP_GRO on `fd`. Returns false when the kernel does not support it; reception works either way.
+    static bool enable_gro(int fd) noexcept;
+
+    udp_batch() : udp_batch(options{}) {}
+    explicit udp_batch(options opts);
+    udp_batch(const udp_batch &) = delete;
+    udp_batch &operator=(const udp_batch &) = delete;
+    ~udp_batch();
+
+    // Receives up to min(out.size(), max_batch) datagrams with one recvmmsg and fills in their size, truncated,
+    // address and segment_size. Returns the number received, 0 when nothing is pending, or -errno.
+    int recv(int fd, std::span<datagram> out) noexcept;
+    // Sends up to min(in.size(), max_batch) datagrams with one sendmmsg. Returns the number sent (the kernel may
+    // stop early when the socket buffer fills), 0 when nothing could be sent right now, or -errno.
+    int send(int fd, std::span<const datagram> in) noexcept;
+
+    std::size_t max_batch() const noexcept { return opts_.max_batch; }
+
+private:
+    struct control_buffer;
+
+    options opts_;
+    std::unique_ptr<mmsghdr[]> headers_;
+    std::unique_ptr<iovec[]> iovecs_;
+    std::unique_ptr<control_buffer[]> controls_;
+};
+
+} // namespace coro_ext
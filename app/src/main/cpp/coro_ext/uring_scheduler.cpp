@@ -0,0 +1,493 @@
+// All code comments are in English per repo policy.
+
+#include "uring_scheduler.hpp"
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace coro_ext {
+
+namespace {
+
+// Not an io_uring opcode: the request only asks to be resumed on the io thread.
+constexpr std::uint8_t kOpSchedule = 0xff;
+// user_data tags that are not io_request pointers (requests are pointer-aligned, so never 1, 2 or 3).
+constexpr std::uint64_t kWakeTag = 1;
+constexpr std::uint64_t kLinkTimeoutTag = 2;
+constexpr std::uint64_t kCancelTag = 3;
+
+static_assert(sizeof(__kernel_timespec) == sizeof(uring_scheduler::io_request{}.timespec));
+
+thread_local const uring_scheduler *tl_current = nullptr;
+
+int sys_io_uring_setup(unsigned entries, io_uring_params *params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+template <typename T>
+T *ring_ptr(void *base, std::uint32_t offset) {
+    return reinterpret_cast<T *>(static_cast<char *>(base) + offset);
+}
+
+} // namespace
+
+bool uring_scheduler::is_supported() noexcept {
+#if defined(__ANDROID__)
+    // The app seccomp filter traps io_uring syscalls (SIGSYS), so do not even probe.
+    return false;
+#else
+    static const bool supported = [] {
+        io_uring_params params{};
+        const int fd = sys_io_uring_setup(4, &params);
+        if (fd < 0) return false;
+        ::close(fd);
+        // FAST_POLL (5.7) makes socket reads/writes poll-driven instead of punting to io-wq threads, and implies
+        // the READ/WRITE/ACCEPT/LINK_TIMEOUT opcodes used here.
+        return (params.features & IORING_FEAT_FAST_POLL) != 0;
+    }();
+    return supported;
+#endif
+}
+
+uring_scheduler::uring_scheduler(options opts) : opts_(std::move(opts)) {
+    if (!is_supported()) throw std::runtime_error("coro_ext::uring_scheduler: io_uring is not available");
+    if (opts_.placement.kind != cpu_placement::policy::none) {
+        opts_.on_io_thread_start_functor =
+            io_thread_start_functor(opts_.placement, std::move(opts_.on_io_thread_start_functor));
+    }
+
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = std::max<std::uint32_t>(opts_.entries, 1) * 2;
+    ring_fd_ = sys_io_uring_setup(std::max<std::uint32_t>(opts_.entries, 1), &params);
+    if (ring_fd_ < 0) {
+        throw std::runtime_error(std::string("coro_ext::uring_scheduler: io_uring_setup failed: ") +
+                                 std::strerror(errno));
+    }
+
+    sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) sq_map_size_ = cq_map_size_ = std::max(sq_map_size_, cq_map_size_);
+    sq_map_ = ::mmap(nullptr, sq_map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                     IORING_OFF_SQ_RING);
+    if (sq_map_ == MAP_FAILED) sq_map_ = nullptr;
+    if (sq_map_ && single_mmap) {
+        cq_map_ = sq_map_;
+    } else if (sq_map_) {
+        cq_map_ = ::mmap(nullptr, cq_map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                         IORING_OFF_CQ_RING);
+        if (cq_map_ == MAP_FAILED) cq_map_ = nullptr;
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_SQES);
+    sqes_ = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe *>(sqes);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (!sq_map_ || !cq_map_ || !sqes_ || wake_fd_ < 0) {
+        const int err = errno;
+        destroy_ring();
+        throw std::runtime_error(std::string("coro_ext::uring_scheduler: ring setup failed: ") + std::strerror(err));
+    }
+
+    sq_head_ = ring_ptr<unsigned>(sq_map_, params.sq_off.head);
+    sq_tail_ = ring_ptr<unsigned>(sq_map_, params.sq_off.tail);
+    sq_mask_ = *ring_ptr<unsigned>(sq_map_, params.sq_off.ring_mask);
+    sq_entries_ = *ring_ptr<unsigned>(sq_map_, params.sq_off.ring_entries);
+    sq_array_ = ring_ptr<unsigned>(sq_map_, params.sq_off.array);
+    cq_head_ = ring_ptr<unsigned>(cq_map_, params.cq_off.head);
+    cq_tail_ = ring_ptr<unsigned>(cq_map_, params.cq_off.tail);
+    cq_mask_ = *ring_ptr<unsigned>(cq_map_, params.cq_off.ring_mask);
+    cq_entries_ = *ring_ptr<unsigned>(cq_map_, params.cq_off.ring_entries);
+    cqes_ = ring_ptr<io_uring_cqe>(cq_map_, params.cq_off.cqes);
+    sq_local_tail_ = *sq_tail_;
+    // SQEs are always consumed in order, so the indirection array is the identity.
+    for (unsigned i = 0; i < sq_entries_; ++i) sq_array_[i] = i;
+
+    local_.reserve(sq_entries_);
+    ready_.reserve(sq_entries_);
+    thread_ = std::thread([this, exited = exited_] {
+        io_loop();
+        // Only the shared flag is touched here: the scheduler may already be gone.
+        exited->store(true, std::memory_order_release);
+        exited->notify_all();
+    });
+}
+
+uring_scheduler::~uring_scheduler() {
+    if (tl_current != this) {
+        shutdown();
+        return;
+    }
+    // Destroyed by a coroutine running on the io thread. io_loop() is further up this stack and must not touch the
+    // object once we return, so finish the drain here: cancel what is in flight and resume every remaining
+    // coroutine, including the rest of the batch this one was resumed from.
+    stopping_.store(true, std::memory_order_release);
+    while (step()) {
+    }
+    if (opts_.on_io_thread_stop_functor) opts_.on_io_thread_stop_functor();
+    tl_current = nullptr; // tells run_ready() and io_loop() to return without touching the object
+    if (thread_.joinable()) thread_.detach();
+    joined_.store(true, std::memory_order_release);
+    wait_for_submitters();
+    destroy_ring();
+}
+
+uring_scheduler::io_operation uring_scheduler::make_operation(std::uint8_t opcode, int fd, std::uint64_t addr,
+                                                              std::uint32_t len, std::uint32_t op_flags,
+                                                              std::chrono::nanoseconds timeout) noexcept {
+    io_request request;
+    request.opcode = opcode;
+    request.fd = fd;
+    request.addr = addr;
+    request.len = len;
+    request.op_flags = op_flags;
+    if (timeout.count() > 0) {
+        request.timed = opcode != IORING_OP_TIMEOUT;
+        request.timespec[0] = timeout.count() / 1'000'000'000;
+        request.timespec[1] = timeout.count() % 1'000'000'000;
+    }
+    return io_operation{*this, request};
+}
+
+uring_scheduler::io_operation uring_scheduler::schedule() noexcept {
+    return make_operation(kOpSchedule, -1, 0, 0, 0, std::chrono::nanoseconds{0});
+}
+
+uring_scheduler::io_operation uring_scheduler::poll(int fd, std::uint32_t events,
+                                                    std::chrono::milliseconds timeout) noexcept {
+    return make_operation(IORING_OP_POLL_ADD, fd, 0, 0, events, timeout);
+}
+
+uring_scheduler::io_operation uring_scheduler::read(int fd, std::span<char> buffer,
+                                                    std::chrono::milliseconds timeout) noexcept {
+    return make_operation(IORING_OP_READ, fd, reinterpret_cast<std::uint64_t>(buffer.data()),
+                          static_cast<std::uint32_t>(buffer.size()), 0, timeout);
+}
+
+uring_scheduler::io_operation uring_scheduler::write(int fd, std::span<const char> buffer,
+                                                     std::chrono::milliseconds timeout) noexcept {
+    return make_operation(IORING_OP_WRITE, fd, reinterpret_cast<std::uint64_t>(buffer.data()),
+                          static_cast<std::uint32_t>(buffer.size()), 0, timeout);
+}
+
+uring_scheduler::io_operation uring_scheduler::accept(int listen_fd, std::chrono::milliseconds timeout) noexcept {
+    return make_operation(IORING_OP_ACCEPT, listen_fd, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC, timeout);
+}
+
+uring_scheduler::io_operation uring_scheduler::sleep(std::chrono::nanoseconds duration) noexcept {
+    return make_operation(IORING_OP_TIMEOUT, -1, 0, 0, 0, std::max(duration, std::chrono::nanoseconds{1}));
+}
+
+void uring_scheduler::submit(io_request &request) noexcept {
+    if (tl_current == this) {
+        // On the io thread: batched into the next io_uring_enter. While stopping, only schedule() still queues, so
+        // draining always terminates.
+        if (request.opcode != kOpSchedule && stopping_.load(std::memory_order_acquire)) {
+            request.result = -ECANCELED;
+            request.handle.resume();
+            return;
+        }
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        local_.push_back(&request);
+        return;
+    }
+    if (joined_.load(std::memory_order_acquire)) {
+        request.result = -ECANCELED;
+        request.handle.resume();
+        return;
+    }
+    submitting_.fetch_add(1, std::memory_order_seq_cst);
+    // Count the request before looking at stopping_: the io thread checks them in the opposite order before it
+    // exits, so either it sees this request pending or we see the stop.
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    if (stopping_.load(std::memory_order_seq_cst)) {
+        // The io thread may be about to exit: complete here instead (schedule() resumes on this thread). It may also
+        // be waiting for the count to drop because of us.
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) wake();
+        submitting_.fetch_sub(1, std::memory_order_release);
+        if (request.opcode != kOpSchedule) request.result = -ECANCELED;
+        request.handle.resume();
+        return;
+    }
+    io_request *head = remote_head_.load(std::memory_order_relaxed);
+    do {
+        request.next = head;
+    } while (!remote_head_.compare_exchange_weak(head, &request, std::memory_order_release, std::memory_order_relaxed));
+    // Pairs with the fence in step(): either the io thread sees the request or we see it sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) && sleeping_.exchange(false, std::memory_order_acq_rel)) wake();
+    // Last access: from here on the request may complete and the scheduler be destroyed.
+    submitting_.fetch_sub(1, std::memory_order_release);
+}
+
+void uring_scheduler::wait_for_submitters() const noexcept {
+    while (submitting_.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+}
+
+void uring_scheduler::wake() noexcept {
+    const std::uint64_t one = 1;
+    [[maybe_unused]] const auto rc = ::write(wake_fd_, &one, sizeof(one));
+}
+
+bool uring_scheduler::take_remote() noexcept {
+    io_request *head = remote_head_.exchange(nullptr, std::memory_order_acquire);
+    if (!head) return false;
+    // The list is LIFO; restore submission order.
+    io_request *fifo = nullptr;
+    while (head) {
+        io_request *next = head->next;
+        head->next = fifo;
+        fifo = head;
+        head = next;
+    }
+    for (; fifo; fifo = fifo->next) local_.push_back(fifo);
+    return true;
+}
+
+io_uring_sqe *uring_scheduler::next_sqe(unsigned reserve) noexcept {
+    // Make room for `reserve` consecutive SQEs so a linked pair is never split across submissions.
+    while (sq_entries_ - (sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)) < reserve) enter(0);
+    io_uring_sqe *sqe = &sqes_[sq_local_tail_ & sq_mask_];
+    std::memset(sqe, 0, sizeof(*sqe));
+    ++sq_local_tail_;
+    ++unsubmitted_;
+    return sqe;
+}
+
+void uring_scheduler::arm_wake_poll() noexcept {
+    io_uring_sqe *sqe = next_sqe(1);
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = wake_fd_;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = kWakeTag;
+    ++cqes_in_flight_;
+}
+
+bool uring_scheduler::prepare(io_request &request) noexcept {
+    if (request.opcode == kOpSchedule) {
+        ready_.push_back(request.handle);
+        pending_.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+    const unsigned needed = request.timed ? 2 : 1;
+    if (cqes_in_flight_ + needed > cq_entries_) return false;
+
+    io_uring_sqe *sqe = next_sqe(needed);
+    sqe->opcode = request.opcode;
+    sqe->fd = request.fd;
+    sqe->addr = request.addr;
+    sqe->len = request.len;
+    sqe->user_data = reinterpret_cast<std::uint64_t>(&request);
+    switch (request.opcode) {
+        case IORING_OP_POLL_ADD:
+            sqe->poll32_events = request.op_flags;
+            break;
+        case IORING_OP_ACCEPT:
+            sqe->accept_flags = request.op_flags;
+            break;
+        case IORING_OP_READ:
+        case IORING_OP_WRITE:
+            sqe->off = static_cast<std::uint64_t>(-1); // current position; ignored for sockets and pipes
+            break;
+        case IORING_OP_TIMEOUT:
+            sqe->addr = reinterpret_cast<std::uint64_t>(request.timespec);
+            sqe->len = 1;
+            break;
+        default:
+            break;
+    }
+    ++cqes_in_flight_;
+    request.prev = nullptr;
+    request.next = in_flight_;
+    if (in_flight_) in_flight_->prev = &request;
+    in_flight_ = &request;
+    if (request.timed) {
+        sqe->flags |= IOSQE_IO_LINK;
+        io_uring_sqe *timeout = next_sqe(1);
+        timeout->opcode = IORING_OP_LINK_TIMEOUT;
+        timeout->fd = -1;
+        timeout->addr = reinterpret_cast<std::uint64_t>(request.timespec);
+        timeout->len = 1;
+        timeout->user_data = kLinkTimeoutTag;
+        ++cqes_in_flight_;
+    }
+    return true;
+}
+
+// Called while stopping: completes requests still waiting for CQ space, and asks the kernel to cancel every request in
+// flight that has not been cancelled yet. Cancellations need CQ slots too; those that do not fit go out on a later
+// pass.
+void uring_scheduler::cancel_in_flight() noexcept {
+    for (io_request *request : backlog_) {
+        if (request->opcode != kOpSchedule) request->result = -ECANCELED;
+        ready_.push_back(request->handle);
+        pending_.fetch_sub(1, std::memory_order_release);
+    }
+    backlog_.clear();
+    for (io_request *request = in_flight_; request; request = request->next) {
+        if (request->cancelled) continue;
+        if (cqes_in_flight_ + 1 > cq_entries_) return;
+        io_uring_sqe *sqe = next_sqe(1);
+        // ASYNC_CANCEL does not find pending timeouts on older kernels; TIMEOUT_REMOVE does.
+        sqe->opcode = request->opcode == IORING_OP_TIMEOUT ? IORING_OP_TIMEOUT_REMOVE : IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = reinterpret_cast<std::uint64_t>(request);
+        sqe->user_data = kCancelTag;
+        ++cqes_in_flight_;
+        request->cancelled = true;
+    }
+}
+
+// Turns queued requests into SQEs. Requests that would overflow the CQ ring wait in backlog_ for completions.
+void uring_scheduler::flush_local() noexcept {
+    if (!local_.empty()) {
+        backlog_.insert(backlog_.end(), local_.begin(), local_.end());
+        local_.clear();
+    }
+    std::size_t done = 0;
+    while (done < backlog_.size() && prepare(*backlog_[done])) ++done;
+    backlog_.erase(backlog_.begin(), backlog_.begin() + static_cast<std::ptrdiff_t>(done));
+}
+
+void uring_scheduler::enter(unsigned min_complete) noexcept {
+    if (unsubmitted_ == 0 && min_complete == 0) return;
+    __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+    const int rc =
+        sys_io_uring_enter(ring_fd_, unsubmitted_, min_complete, min_complete > 0 ? IORING_ENTER_GETEVENTS : 0);
+    // On EINTR/EAGAIN/EBUSY the unsubmitted SQEs stay queued and go out with the next call.
+    if (rc > 0) unsubmitted_ -= std::min<unsigned>(static_cast<unsigned>(rc), unsubmitted_);
+}
+
+void uring_scheduler::reap() noexcept {
+    unsigned head = __atomic_load_n(cq_head_, __ATOMIC_RELAXED);
+    const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    bool rearm_wake = false;
+    for (; head != tail; ++head) {
+        const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+        --cqes_in_flight_;
+        if (cqe.user_data == kWakeTag) {
+            std::uint64_t value = 0;
+            [[maybe_unused]] const auto rc = ::read(wake_fd_, &value, sizeof(value));
+            rearm_wake = true;
+            continue;
+        }
+        if (cqe.user_data == kLinkTimeoutTag || cqe.user_data == kCancelTag) continue;
+        auto *request = reinterpret_cast<io_request *>(cqe.user_data);
+        if (request->prev) {
+            request->prev->next = request->next;
+        } else {
+            in_flight_ = request->next;
+        }
+        if (request->next) request->next->prev = request->prev;
+        int result = cqe.res;
+        if (request->timed && !request->cancelled && result == -ECANCELED) result = -ETIME; // linked timeout fired
+        if (request->opcode == IORING_OP_TIMEOUT && result == -ETIME) result = 0;
+        request->result = result;
+        ready_.push_back(request->handle);
+        pending_.fetch_sub(1, std::memory_order_release);
+    }
+    // Release the slots before resuming anyone, so the kernel can post new completions into them.
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    if (rearm_wake) arm_wake_poll();
+}
+
+// Resumes ready_ in order. Returns false when a coroutine destroyed the scheduler; the destructor has then resumed the
+// rest of the batch itself, and nothing of the object may be touched any more.
+bool uring_scheduler::run_ready() {
+    while (ready_head_ < ready_.size()) {
+        const auto handle = ready_[ready_head_++];
+        handle.resume();
+        if (tl_current != this) return false;
+    }
+    ready_.clear();
+    ready_head_ = 0;
+    return true;
+}
+
+// One loop iteration. Returns false once stopping with nothing pending, or when the scheduler was destroyed.
+bool uring_scheduler::step() {
+    take_remote();
+    flush_local();
+    // After flush_local(), so requests prepared in this iteration are cancelled in the same submission.
+    if (stopping_.load(std::memory_order_acquire)) cancel_in_flight();
+    if (ready_head_ < ready_.size()) {
+        // Submit what is queued so far without waiting, then run resumable coroutines; their follow-up operations
+        // join the next batch.
+        enter(0);
+        reap();
+        return run_ready();
+    }
+    if (stopping_.load(std::memory_order_seq_cst) && pending_.load(std::memory_order_seq_cst) == 0) return false;
+
+    unsigned min_complete = 1;
+    sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (remote_head_.load(std::memory_order_acquire) != nullptr) min_complete = 0;
+    enter(min_complete);
+    sleeping_.store(false, std::memory_order_relaxed);
+    reap();
+    return run_ready();
+}
+
+void uring_scheduler::io_loop() {
+    tl_current = this;
+    if (opts_.on_io_thread_start_functor) opts_.on_io_thread_start_functor();
+    arm_wake_poll();
+    while (step()) {
+    }
+    if (tl_current != this) return; // destroyed from a coroutine; the destructor finished up
+    if (opts_.on_io_thread_stop_functor) opts_.on_io_thread_stop_functor();
+    tl_current = nullptr;
+}
+
+void uring_scheduler::shutdown() noexcept {
+    if (ring_fd_ < 0) return;
+    stopping_.store(true, std::memory_order_release);
+    if (tl_current == this) {
+        // A thread cannot join itself: the loop cancels what is in flight and exits once drained. The ring is
+        // released by the destructor (or a later shutdown()) on another thread, after waiting for the exit.
+        if (thread_.joinable()) thread_.detach();
+        return;
+    }
+    wake();
+    if (thread_.joinable()) {
+        thread_.join();
+    } else {
+        exited_->wait(false, std::memory_order_acquire);
+    }
+    if (!joined_.exchange(true, std::memory_order_acq_rel)) {
+        wait_for_submitters();
+        destroy_ring();
+    }
+}
+
+void uring_scheduler::destroy_ring() noexcept {
+    if (sqes_) ::munmap(sqes_, sqes_size_);
+    if (cq_map_ && cq_map_ != sq_map_) ::munmap(cq_map_, cq_map_size_);
+    if (sq_map_) ::munmap(sq_map_, sq_map_size_);
+    sqes_ = nullptr;
+    cq_map_ = nullptr;
+    sq_map_ = nullptr;
+    if (wake_fd_ >= 0) ::close(wake_fd_);
+    if (ring_fd_ >= 0) ::close(ring_fd_);
+    wake_fd_ = -1;
+    ring_fd_ = -1;
+}
+
+} // namespace coro_ext
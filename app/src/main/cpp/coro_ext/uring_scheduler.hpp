@@ -0,0 +1,182 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include "cpu_affinity.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace coro_ext {
+
+// io_uring-backed I/O scheduler for Linux hosts: the io_uring counterpart of coro::io_scheduler (epoll).
+//
+// One io thread owns the ring. Operations started on the io thread (the common case: a coroutine resumed by a
+// completion issues its next read/write) are queued without atomics and submitted together by a single
+// io_uring_enter per loop iteration; operations started on other threads go through a lock-free list and an eventfd
+// wake-up. Completions are reaped from the shared CQ ring without a syscall and their coroutines are resumed inline on
+// the io thread (like coro::io_scheduler's process_tasks_inline strategy).
+//
+// Operations return the raw io_uring result: >= 0 on success (bytes, accepted fd, poll revents), -errno on failure,
+// -ETIME when the optional timeout expired first.
+//
+// io_uring is unavailable on Android (blocked by the app seccomp policy) and on kernels older than 5.7; check
+// is_supported() and fall back to coro::io_scheduler.
+//
+// shutdown() cancels the operations still in flight (they complete with -ECANCELED), resumes their coroutines and
+// stops the io thread. It may also be called on the io thread, and so may the destructor. A destructor running there
+// finishes the drain inline before it returns.
+class uring_scheduler {
+public:
+    struct options {
+        // Submission queue size (rounded up to a power of two by the kernel); the completion queue is twice as large.
+        std::uint32_t entries = 256;
+        // io thread CPU placement, applied before on_io_thread_start_functor runs.
+        cpu_placement placement{};
+        std::function<void()> on_io_thread_start_functor = nullptr;
+        std::function<void()> on_io_thread_stop_functor = nullptr;
+    };
+
+    // One queued operation. Lives in the awaiting coroutine's frame until it completes.
+    struct io_request {
+        // Remote submission list, then the io thread's list of requests in flight.
+        io_request *next = nullptr;
+        io_request *prev = nullptr;
+        std::coroutine_handle<> handle;
+        std::uint8_t opcode = 0;
+        int fd = -1;
+        std::uint64_t addr = 0;
+        std::uint32_t len = 0;
+        std::uint32_t op_flags = 0;
+        bool timed = false;                // a linked timeout is attached
+        bool cancelled = false;            // shutdown() asked the kernel to cancel it
+        std::int64_t timespec[2] = {0, 0}; // __kernel_timespec {tv_sec, tv_nsec}; read by the kernel at submission
+        int result = 0;
+    };
+
+    class io_operation {
+    public:
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) noexcept {
+            request_.handle = handle;
+            scheduler_.submit(request_);
+        }
+        int await_resume() const noexcept { return request_.result; }
+
+    private:
+        friend class uring_scheduler;
+        io_operation(uring_scheduler &scheduler, const io_request &request) noexcept
+            : scheduler_(scheduler), request_(request) {}
+
+        uring_scheduler &scheduler_;
+        io_request request_;
+    };
+
+    // True when this process can create an io_uring supporting the operations used here.
+    static bool is_supported() noexcept;
+
+    uring_scheduler() : uring_scheduler(options{}) {}
+    // Throws std::runtime_error when the ring cannot be created (see is_supported()).
+    explicit uring_scheduler(options opts);
+    uring_scheduler(const uring_scheduler &) = delete;
+    uring_scheduler &operator=(const uring_scheduler &) = delete;
+    ~uring_scheduler();
+
+    // Moves the awaiting coroutine onto the io thread.
+    [[nodiscard]] io_operation schedule() noexcept;
+    // Waits for `events` (POLLIN/POLLOUT/...) on fd; returns the ready revents.
+    [[nodiscard]] io_operation poll(int fd, std::uint32_t events,
+                                    std::chrono::milliseconds timeout = std::chrono::milliseconds{0}) noexcept;
+    [[nodiscard]] io_operation read(int fd, std::span<char> buffer,
+                                    std::chrono::milliseconds timeout = std::chrono::milliseconds{0}) noexcept;
+    [[nodiscard]] io_operation write(int fd, std::span<const char> buffer,
+                                     std::chrono::milliseconds timeout = std::chrono::milliseconds{0}) noexcept;
+    // Accepts one connection on a listening socket; the new fd is non-blocking and close-on-exec.
+    [[nodiscard]] io_operation accept(int listen_fd,
+                                      std::chrono::milliseconds timeout = std::chrono::milliseconds{0}) noexcept;
+    // Completes with 0 after `duration`.
+    [[nodiscard]] io_operation sleep(std::chrono::nanoseconds duration) noexcept;
+
+    // Cancels in-flight operations, resumes their coroutines, then stops the io thread and releases the ring. Once
+    // stopping, new operations complete with -ECANCELED right away, and schedule() from another thread resumes on
+    // that thread. Called on the io thread it only requests the stop: the thread is detached and exits once drained,
+    // and a later call from another thread waits for that. Idempotent.
+    void shutdown() noexcept;
+
+    // Operations submitted but not yet completed.
+    std::size_t size() const noexcept { return pending_.load(std::memory_order_acquire); }
+
+private:
+    io_operation make_operation(std::uint8_t opcode, int fd, std::uint64_t addr, std::uint32_t len,
+                                std::uint32_t op_flags, std::chrono::nanoseconds timeout) noexcept;
+    void submit(io_request &request) noexcept;
+    void io_loop();
+    bool step();
+    bool prepare(io_request &request) noexcept;
+    void cancel_in_flight() noexcept;
+    void flush_local() noexcept;
+    io_uring_sqe *next_sqe(unsigned reserve) noexcept;
+    void arm_wake_poll() noexcept;
+    bool take_remote() noexcept;
+    void reap() noexcept;
+    bool run_ready();
+    void enter(unsigned min_complete) noexcept;
+    void wake() noexcept;
+    void wait_for_submitters() const noexcept;
+    void destroy_ring() noexcept;
+
+    options opts_;
+    int ring_fd_ = -1;
+    int wake_fd_ = -1;
+
+    // Ring mappings (see io_uring_setup(2)).
+    void *sq_map_ = nullptr;
+    std::size_t sq_map_size_ = 0;
+    void *cq_map_ = nullptr;
+    std::size_t cq_map_size_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    std::size_t sqes_size_ = 0;
+    unsigned *sq_head_ = nullptr;
+    unsigned *sq_tail_ = nullptr;
+    unsigned *sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned *cq_head_ = nullptr;
+    unsigned *cq_tail_ = nullptr;
+    io_uring_cqe *cqes_ = nullptr;
+    unsigned cq_mask_ = 0;
+    unsigned cq_entries_ = 0;
+
+    // io-thread-owned state.
+    unsigned sq_local_tail_ = 0;
+    unsigned unsubmitted_ = 0;
+    std::size_t cqes_in_flight_ = 0; // bounded by cq_entries_ so the CQ ring never overflows
+    std::vector<io_request *> local_;
+    std::vector<io_request *> backlog_;
+    std::vector<std::coroutine_handle<>> ready_;
+    std::size_t ready_head_ = 0; // next entry of ready_ to resume
+    io_request *in_flight_ = nullptr;
+
+    alignas(64) std::atomic<io_request *> remote_head_{nullptr};
+    // Remote submit() calls in progress; they touch the scheduler after publishing, so teardown waits for them.
+    std::atomic<std::uint32_t> submitting_{0};
+    std::atomic<bool> sleeping_{false};
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> joined_{false};
+    std::thread thread_;
+    // Set by the io thread when io_loop() returns; shared so it stays valid if the thread was detached.
+    std::shared_ptr<std::atomic<bool>> exited_ = std::make_shared<std::atomic<bool>>(false);
+};
+
+} // namespace coro_ext
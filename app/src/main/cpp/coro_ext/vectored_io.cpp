@@ -0,0 +1,117 @@
+// All code comments are in English per repo policy.
+
+#include "vectored_io.hpp"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <array>
+#include <cerrno>
+
+namespace coro_ext {
+
+namespace {
+
+// Position in a span of buffers: the next byte is parts[index][offset]. Exhausted and empty parts are skipped, so
+// index == parts.size() means done.
+template <typename part_type>
+struct cursor {
+    std::span<const part_type> parts;
+    std::size_t index = 0;
+    std::size_t offset = 0;
+
+    explicit cursor(std::span<const part_type> p) noexcept : parts(p) { skip_exhausted(); }
+
+    bool done() const noexcept { return index == parts.size(); }
+
+    void skip_exhausted() noexcept {
+        while (index < parts.size() && offset == parts[index].size()) {
+            ++index;
+            offset = 0;
+        }
+    }
+
+    // Fills `iov` from the current position; returns the number of entries used.
+    std::size_t fill(std::array<iovec, max_parts_per_call> &iov) const noexcept {
+        std::size_t count = 0;
+        std::size_t off = offset;
+        for (std::size_t i = index; i < parts.size() && count < iov.size(); ++i, off = 0) {
+            if (parts[i].size() == off) continue;
+            iov[count++] = iovec{const_cast<char *>(parts[i].data()) + off, parts[i].size() - off};
+        }
+        return count;
+    }
+
+    void advance(std::size_t bytes) noexcept {
+        while (bytes > 0 && index < parts.size()) {
+            const std::size_t remaining = parts[index].size() - offset;
+            if (bytes < remaining) {
+                offset += bytes;
+                return;
+            }
+            bytes -= remaining;
+            ++index;
+            offset = 0;
+        }
+        skip_exhausted();
+    }
+};
+
+std::int64_t poll_failure(coro::poll_status status) noexcept {
+    return status == coro::poll_status::closed ? -ECONNRESET : -EIO;
+}
+
+} // namespace
+
+coro::task<std::int64_t> write_all(std::shared_ptr<coro::io_scheduler> scheduler, int fd,
+                                   std::span<const std::span<const char>> parts) {
+    co_await scheduler->schedule();
+    cursor<std::span<const char>> pos{parts};
+    std::int64_t total = 0;
+    std::array<iovec, max_parts_per_call> iov;
+    while (!pos.done()) {
+        msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = pos.fill(iov);
+        const ssize_t n = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (n < 0) {
+            const int err = errno;
+            if (err == EINTR) continue;
+            if (err != EAGAIN && err != EWOULDBLOCK) co_return -err;
+            const auto status = co_await scheduler->poll(fd, coro::poll_op::write);
+            if (status != coro::poll_status::event) co_return poll_failure(status);
+            continue;
+        }
+        total += n;
+        pos.advance(static_cast<std::size_t>(n));
+    }
+    co_return total;
+}
+
+coro::task<std::int64_t> read_exact(std::shared_ptr<coro::io_scheduler> scheduler, int fd,
+                                    std::span<const std::span<char>> parts) {
+    co_await scheduler->schedule();
+    cursor<std::span<char>> pos{parts};
+    std::int64_t total = 0;
+    std::array<iovec, max_parts_per_call> iov;
+    while (!pos.done()) {
+        msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = pos.fill(iov);
+        const ssize_t n = ::recvmsg(fd, &msg, 0);
+        if (n < 0) {
+            const int err = errno;
+            if (err == EINTR) continue;
+            if (err != EAGAIN && err != EWOULDBLOCK) co_return -err;
+            const auto status = co_await scheduler->poll(fd, coro::poll_op::read);
+            if (status != coro::poll_status::event) co_return poll_failure(status);
+            continue;
+        }
+        if (n == 0) break; // peer closed
+        total += n;
+        pos.advance(static_cast<std::size_t>(n));
+    }
+    co_return total;
+}
+
+} // namespace coro_ext
@@ -0,0 +1,35 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <coro/coro.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace coro_ext {
+
+// Scatter/gather I/O for non-blocking stream sockets, e.g. the native handle of a coro::net::tcp::client socket or a
+// connection accepted by coro_ext::reactor_server. tcp::client::send()/recv() take one buffer per call, so a framed
+// message is either copied into one buffer or sent with a syscall per part. These helpers move every part with one
+// gather sendmsg() / scatter recvmsg() (writev()/readv() semantics) instead, and wait for readiness through
+// `scheduler` when the socket would block. Like every coroutine here they first schedule onto `scheduler`, so the
+// socket is only touched from its io_scheduler.
+//
+// Results are the byte count on success or -errno, like coro_ext::uring_scheduler. At most max_parts_per_call
+// buffers are passed per syscall; longer spans take several calls.
+
+inline constexpr std::size_t max_parts_per_call = 64;
+
+// Writes all of `parts`, in order. Returns the total number of bytes written, or -errno (-EPIPE/-ECONNRESET when the
+// peer went away). Uses MSG_NOSIGNAL, so a closed peer never raises SIGPIPE.
+coro::task<std::int64_t> write_all(std::shared_ptr<coro::io_scheduler> scheduler, int fd,
+                                   std::span<const std::span<const char>> parts);
+
+// Fills all of `parts`, in order. Returns the total number of bytes read, which is less than the total size only
+// when the peer closed the connection first, or -errno.
+coro::task<std::int64_t> read_exact(std::shared_ptr<coro::io_scheduler> scheduler, int fd,
+                                    std::span<const std::span<char>> parts);
+
+} // namespace coro_ext
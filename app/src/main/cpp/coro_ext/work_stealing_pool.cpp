@@ -0,0 +1,291 @@
+// All code comments are in English per repo policy.
+
+#include "work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace coro_ext {
+
+namespace {
+
+// Owner-side scheduling policy knobs.
+constexpr std::uint64_t kInjectCheckInterval = 61; // look at the injection queue first every N ticks
+constexpr std::uint64_t kFifoPopInterval = 31;     // take the oldest local item every N ticks
+constexpr std::uint32_t kMaxLifoStreak = 32;       // consecutive LIFO-slot runs before the slot is requeued
+constexpr std::size_t kMaxInjectBatch = 32;        // items moved from the injection queue per lock
+constexpr int kSpinRounds = 16;                    // steal attempts before parking
+
+thread_local const void *tl_pool = nullptr;
+thread_local void *tl_worker = nullptr;
+
+std::uint64_t xorshift64(std::uint64_t &state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // namespace
+
+work_stealing_pool::work_deque::work_deque(std::size_t capacity) {
+    std::size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+    buffer_ = std::make_unique<std::atomic<void *>[]>(cap);
+    mask_ = static_cast<std::int64_t>(cap - 1);
+}
+
+bool work_stealing_pool::work_deque::push(void *item) noexcept {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t t = top_.load(std::memory_order_acquire);
+    if (b - t > mask_) return false;
+    buffer_[b & mask_].store(item, std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+void *work_stealing_pool::work_deque::pop() noexcept {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    void *item = buffer_[b & mask_].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last item: race against thieves for it.
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            item = nullptr;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+}
+
+void *work_stealing_pool::work_deque::steal() noexcept {
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+    void *item = buffer_[t & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr; // lost the race; caller retries elsewhere
+    }
+    return item;
+}
+
+bool work_stealing_pool::work_deque::empty() const noexcept {
+    return bottom_.load(std::memory_order_acquire) <= top_.load(std::memory_order_acquire);
+}
+
+work_stealing_pool::work_stealing_pool(options opts) : opts_(std::move(opts)) {
+    if (opts_.thread_count == 0) opts_.thread_count = std::max(1u, std::thread::hardware_concurrency());
+    if (opts_.placement.kind != cpu_placement::policy::none) {
+        opts_.on_thread_start_functor = thread_start_functor(opts_.placement, std::move(opts_.on_thread_start_functor));
+    }
+    workers_.reserve(opts_.thread_count);
+    for (std::uint32_t i = 0; i < opts_.thread_count; ++i) {
+        auto w = std::make_unique<worker>(opts_.local_queue_capacity);
+        w->rng = 0x9e3779b97f4a7c15ull * (i + 1);
+        workers_.push_back(std::move(w));
+    }
+    // Start threads only once every worker exists, since thieves index workers_.
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread([this, i] { worker_loop(i); });
+    }
+}
+
+work_stealing_pool::~work_stealing_pool() {
+    shutdown();
+    // A shutdown() from inside a task left the calling worker running; it may still be draining or returning through
+    // worker_loop(), so wait for it before the workers are freed.
+    for (auto &w : workers_) {
+        if (w->thread.joinable()) w->thread.join();
+    }
+}
+
+work_stealing_pool::worker *work_stealing_pool::current_worker() const noexcept {
+    return tl_pool == this ? static_cast<worker *>(tl_worker) : nullptr;
+}
+
+void work_stealing_pool::schedule_impl(std::coroutine_handle<> handle, bool yield) noexcept {
+    worker *w = current_worker();
+    if (w && !yield) {
+        push_local(*w, handle.address());
+    } else if (!inject(handle.address())) {
+        // No workers left to run it; resume inline rather than leaking the coroutine.
+        handle.resume();
+        return;
+    }
+    notify_one_sleeper();
+}
+
+bool work_stealing_pool::resume(std::coroutine_handle<> handle) noexcept {
+    if (!handle || handle.done()) return false;
+    worker *w = current_worker();
+    if (!w) {
+        if (!inject(handle.address())) return false;
+        notify_one_sleeper();
+        return true;
+    }
+    // Locally resumed continuation: run it next on this worker. The previous occupant becomes stealable.
+    if (void *previous = std::exchange(w->lifo_slot, handle.address())) {
+        push_local(*w, previous);
+        notify_one_sleeper();
+    }
+    return true;
+}
+
+void work_stealing_pool::push_local(worker &w, void *item) noexcept {
+    // The calling worker is still running, so it drains the injection queue before exiting even when shutdown()
+    // has already closed it.
+    if (!w.deque.push(item)) {
+        std::lock_guard<std::mutex> lk(inject_mutex_);
+        inject_queue_.push_back(item);
+        inject_size_.store(inject_queue_.size(), std::memory_order_release);
+    }
+}
+
+bool work_stealing_pool::inject(void *item) noexcept {
+    std::lock_guard<std::mutex> lk(inject_mutex_);
+    if (inject_closed_) return false;
+    inject_queue_.push_back(item);
+    inject_size_.store(inject_queue_.size(), std::memory_order_release);
+    return true;
+}
+
+// Takes one injected item and moves a fair share of the rest into the caller's deque, amortizing the lock.
+void *work_stealing_pool::take_injected(worker &w) noexcept {
+    if (inject_size_.load(std::memory_order_acquire) == 0) return nullptr;
+    void *item = nullptr;
+    std::size_t moved = 0;
+    {
+        std::lock_guard<std::mutex> lk(inject_mutex_);
+        if (inject_queue_.empty()) return nullptr;
+        item = inject_queue_.front();
+        inject_queue_.pop_front();
+        const std::size_t share = std::min(kMaxInjectBatch, inject_queue_.size() / workers_.size());
+        while (moved < share && w.deque.push(inject_queue_.front())) {
+            inject_queue_.pop_front();
+            ++moved;
+        }
+        inject_size_.store(inject_queue_.size(), std::memory_order_release);
+    }
+    if (moved > 0) notify_one_sleeper();
+    return item;
+}
+
+void *work_stealing_pool::steal_from_others(worker &w) noexcept {
+    const std::size_t n = workers_.size();
+    if (n < 2) return nullptr;
+    const std::size_t start = static_cast<std::size_t>(xorshift64(w.rng) % n);
+    for (std::size_t i = 0; i < n; ++i) {
+        worker &victim = *workers_[(start + i) % n];
+        if (&victim == &w) continue;
+        if (void *item = victim.deque.steal()) return item;
+    }
+    return nullptr;
+}
+
+void *work_stealing_pool::find_work(worker &w, std::uint64_t tick) noexcept {
+    if (tick % kInjectCheckInterval == 0) {
+        if (void *item = take_injected(w)) return item;
+    }
+    if (w.lifo_slot) {
+        void *item = std::exchange(w.lifo_slot, nullptr);
+        if (w.lifo_streak++ < kMaxLifoStreak) return item;
+        // A continuation chain has monopolized this worker; requeue it behind older local work.
+        push_local(w, item);
+        w.lifo_streak = 0;
+        if (void *oldest = w.deque.steal()) return oldest;
+    }
+    w.lifo_streak = 0;
+    if (void *item = (tick % kFifoPopInterval == 0) ? w.deque.steal() : w.deque.pop()) return item;
+    if (void *item = w.deque.pop()) return item;
+    if (void *item = take_injected(w)) return item;
+    return steal_from_others(w);
+}
+
+bool work_stealing_pool::has_work() noexcept {
+    if (inject_size_.load(std::memory_order_acquire) != 0) return true;
+    for (auto &w : workers_) {
+        if (!w->deque.empty()) return true;
+    }
+    return false;
+}
+
+void work_stealing_pool::notify_one_sleeper() noexcept {
+    // Pairs with the fence in worker_loop: either we see the sleeper or it sees the work we just queued.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) == 0) return;
+    wake_epoch_.fetch_add(1, std::memory_order_release);
+    wake_epoch_.notify_one();
+}
+
+void work_stealing_pool::worker_loop(std::size_t index) {
+    worker &w = *workers_[index];
+    tl_pool = this;
+    tl_worker = &w;
+    if (opts_.on_thread_start_functor) opts_.on_thread_start_functor(index);
+
+    std::uint64_t tick = 0;
+    for (;;) {
+        void *item = find_work(w, ++tick);
+        for (int spin = 0; !item && spin < kSpinRounds; ++spin) {
+            std::this_thread::yield();
+            item = find_work(w, ++tick);
+        }
+        if (item) {
+            std::coroutine_handle<>::from_address(item).resume();
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) {
+            if (!has_work()) break;
+            continue;
+        }
+        // Park until new work is published or shutdown starts.
+        const std::uint32_t epoch = wake_epoch_.load(std::memory_order_acquire);
+        sleepers_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!has_work() && !stopping_.load(std::memory_order_acquire)) {
+            wake_epoch_.wait(epoch, std::memory_order_acquire);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (opts_.on_thread_stop_functor) opts_.on_thread_stop_functor(index);
+    tl_pool = nullptr;
+    tl_worker = nullptr;
+}
+
+void work_stealing_pool::shutdown() noexcept {
+    if (stopping_.exchange(true, std::memory_order_acq_rel)) return;
+    wake_epoch_.fetch_add(1, std::memory_order_release);
+    wake_epoch_.notify_all();
+    bool on_worker = false;
+    for (auto &w : workers_) {
+        if (!w->thread.joinable()) continue;
+        if (w->thread.get_id() == std::this_thread::get_id()) {
+            on_worker = true; // shutdown from inside a task: the worker exits on its own and the destructor joins it
+        } else {
+            w->thread.join();
+        }
+    }
+    // Work injected from other threads after the workers last checked has_work() is still queued. Close the queue,
+    // so later schedules resume inline, and run what is left. From inside a task, the calling worker is still alive
+    // and drains the queue itself before it exits.
+    std::deque<void *> orphans;
+    {
+        std::lock_guard<std::mutex> lk(inject_mutex_);
+        inject_closed_ = true;
+        if (!on_worker) {
+            orphans.swap(inject_queue_);
+            inject_size_.store(0, std::memory_order_release);
+        }
+    }
+    for (void *item : orphans) std::coroutine_handle<>::from_address(item).resume();
+}
+
+} // namespace coro_ext
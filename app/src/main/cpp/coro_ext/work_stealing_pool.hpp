@@ -0,0 +1,123 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include "cpu_affinity.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace coro_ext {
+
+// Work-stealing coroutine scheduler with the same awaitable surface as coro::thread_pool (schedule/yield/resume), so
+// coro::task, coro::when_all and friends can run on it unchanged.
+//
+// Every worker owns a bounded Chase-Lev deque. Work scheduled from a worker goes to its own deque; work scheduled
+// from outside goes to a shared injection queue that workers drain in batches. Handles resumed from a worker are
+// placed in a per-worker LIFO slot and run next while their frame is still cache-hot. Idle workers steal from the top
+// of randomly chosen victims before parking.
+class work_stealing_pool {
+public:
+    struct options {
+        // Number of worker threads; 0 means std::thread::hardware_concurrency().
+        std::uint32_t thread_count = 0;
+        // Capacity of each worker deque (rounded up to a power of two); overflow spills to the injection queue.
+        std::size_t local_queue_capacity = 1024;
+        // Worker CPU placement, applied by each worker before on_thread_start_functor runs.
+        cpu_placement placement{};
+        std::function<void(std::size_t)> on_thread_start_functor = nullptr;
+        std::function<void(std::size_t)> on_thread_stop_functor = nullptr;
+    };
+
+    class schedule_operation {
+    public:
+        explicit schedule_operation(work_stealing_pool &pool, bool yield) noexcept : pool_(pool), yield_(yield) {}
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) noexcept { pool_.schedule_impl(handle, yield_); }
+        void await_resume() const noexcept {}
+
+    private:
+        work_stealing_pool &pool_;
+        bool yield_;
+    };
+
+    work_stealing_pool() : work_stealing_pool(options{}) {}
+    explicit work_stealing_pool(options opts);
+    work_stealing_pool(const work_stealing_pool &) = delete;
+    work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+    // Shuts down and joins every worker, including one that called shutdown() from inside a task. Must not run on
+    // one of the pool's own workers.
+    ~work_stealing_pool();
+
+    // Moves the awaiting coroutine onto the pool (the caller's own deque when already on a worker).
+    [[nodiscard]] schedule_operation schedule() noexcept { return schedule_operation{*this, false}; }
+    // Reschedules behind already queued work (FIFO through the injection queue), so loops that yield stay fair.
+    [[nodiscard]] schedule_operation yield() noexcept { return schedule_operation{*this, true}; }
+    // Resumes a suspended handle on the pool; from a worker it takes the LIFO slot. Returns false after shutdown.
+    bool resume(std::coroutine_handle<> handle) noexcept;
+
+    // Stops accepting work, lets workers drain every queue, then joins them. Idempotent. Called from inside a task,
+    // it joins the other workers and leaves the calling one to exit once it has drained; the destructor joins it.
+    void shutdown() noexcept;
+
+    std::size_t thread_count() const noexcept { return workers_.size(); }
+
+private:
+    // Bounded Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models", 2013).
+    class work_deque {
+    public:
+        explicit work_deque(std::size_t capacity);
+        bool push(void *item) noexcept; // owner only; false when full
+        void *pop() noexcept;           // owner only, LIFO end
+        void *steal() noexcept;         // any thread, FIFO end
+        bool empty() const noexcept;
+
+    private:
+        alignas(64) std::atomic<std::int64_t> top_{0};
+        alignas(64) std::atomic<std::int64_t> bottom_{0};
+        std::unique_ptr<std::atomic<void *>[]> buffer_;
+        std::int64_t mask_;
+    };
+
+    struct alignas(64) worker {
+        explicit worker(std::size_t capacity) : deque(capacity) {}
+        work_deque deque;
+        void *lifo_slot = nullptr; // owner only, never stolen
+        std::uint32_t lifo_streak = 0;
+        std::uint64_t rng = 0;
+        std::thread thread;
+    };
+
+    void schedule_impl(std::coroutine_handle<> handle, bool yield) noexcept;
+    void push_local(worker &w, void *item) noexcept;
+    bool inject(void *item) noexcept;
+    void *take_injected(worker &w) noexcept;
+    void *find_work(worker &w, std::uint64_t tick) noexcept;
+    void *steal_from_others(worker &w) noexcept;
+    bool has_work() noexcept;
+    void notify_one_sleeper() noexcept;
+    void worker_loop(std::size_t index);
+    worker *current_worker() const noexcept;
+
+    options opts_;
+    std::vector<std::unique_ptr<worker>> workers_;
+
+    std::mutex inject_mutex_;
+    std::deque<void *> inject_queue_;
+    // Set by shutdown() once the workers are gone; afterwards inject() refuses work. Guarded by inject_mutex_.
+    bool inject_closed_ = false;
+    alignas(64) std::atomic<std::size_t> inject_size_{0};
+
+    alignas(64) std::atomic<std::uint32_t> sleepers_{0};
+    std::atomic<std::uint32_t> wake_epoch_{0};
+    std::atomic<bool> stopping_{false};
+};
+
+} // namespace coro_ext
@@ -0,0 +1,173 @@
+// All code comments are in English per repo policy.
+
+#include "log_pipeline.hpp"
+
+#include <utility>
+
+namespace {
+
+// Set in enqueue_pos_ by stop(). Claiming a slot is a CAS on enqueue_pos_, so once the bit is set no producer can
+// claim another slot, and every slot claimed before it is drained by the consumer before it exits.
+constexpr std::uint64_t kClosedBit = std::uint64_t{1} << 63;
+
+} // namespace
+
+LogPipeline::~LogPipeline() {
+    stop();
+}
+
+bool LogPipeline::start(Options options) {
+    if (running_.load(std::memory_order_acquire) || thread_.joinable()) return false;
+    std::size_t capacity = 2;
+    while (capacity < options.capacity) capacity <<= 1;
+    options_ = std::move(options);
+    slots_ = std::make_unique<Slot[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    mask_ = capacity - 1;
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_ = 0;
+    delivered_.store(0, std::memory_order_relaxed);
+    stop_requested_.store(false, std::memory_order_relaxed);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { consumer_loop(); });
+    return true;
+}
+
+void LogPipeline::stop() {
+    if (!thread_.joinable()) return;
+    enqueue_pos_.fetch_or(kClosedBit, std::memory_order_seq_cst);
+    stop_requested_.store(true, std::memory_order_seq_cst);
+    wake_consumer();
+    thread_.join();
+    running_.store(false, std::memory_order_release);
+}
+
+bool LogPipeline::push(std::string line) {
+    Record record;
+    record.owned = std::move(line);
+    return push_record(std::move(record));
+}
+
+bool LogPipeline::push(std::shared_ptr<const void> keepalive, std::string_view text) {
+    Record record;
+    record.keepalive = std::move(keepalive);
+    record.borrowed = text;
+    return push_record(std::move(record));
+}
+
+bool LogPipeline::push_record(Record record) {
+    if (!running_.load(std::memory_order_acquire) || stop_requested_.load(std::memory_order_relaxed)) return false;
+    std::uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    for (;;) {
+        // A failed CAS reloads pos, so a stop() racing with this push is always seen before a slot is claimed.
+        if (pos & kClosedBit) return false;
+        slot = &slots_[pos & mask_];
+        const std::uint64_t seq = slot->seq.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::int64_t>(seq) - static_cast<std::int64_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // Ring is full: make sure the consumer is awake and let it catch up.
+            wake_consumer();
+            std::this_thread::yield();
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->record = std::move(record);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    // Pairs with the fence in consumer_loop: either we observe sleeping_ or the consumer observes our slot.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) wake_consumer();
+    return true;
+}
+
+void LogPipeline::flush() {
+    if (!thread_.joinable() || std::this_thread::get_id() == thread_.get_id()) return;
+    const std::uint64_t target = enqueue_pos_.load(std::memory_order_acquire) & ~kClosedBit;
+    flush_waiters_.fetch_add(1, std::memory_order_seq_cst);
+    wake_consumer();
+    std::uint64_t seen = delivered_.load(std::memory_order_acquire);
+    while (seen < target && running_.load(std::memory_order_acquire)) {
+        delivered_.wait(seen, std::memory_order_acquire);
+        seen = delivered_.load(std::memory_order_acquire);
+    }
+    flush_waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool LogPipeline::ring_empty() const noexcept {
+    const Slot &slot = slots_[dequeue_pos_ & mask_];
+    return slot.seq.load(std::memory_order_acquire) != dequeue_pos_ + 1;
+}
+
+void LogPipeline::wake_consumer() noexcept {
+    wake_seq_.fetch_add(1, std::memory_order_release);
+    wake_seq_.notify_one();
+}
+
+void LogPipeline::consumer_loop() {
+    if (options_.on_thread_start) options_.on_thread_start();
+
+    std::vector<std::string_view> lines;
+    std::string joined;
+    joined.reserve(64 * 1024);
+
+    for (;;) {
+        // Drain up to one batch. Each record is copied once into the batch buffer and released right away, so
+        // borrowed capture chunks go back to their owner before the (slow) sink runs.
+        std::size_t records = 0;
+        joined.clear();
+        while (records < options_.max_batch_records) {
+            Slot &slot = slots_[dequeue_pos_ & mask_];
+            if (slot.seq.load(std::memory_order_acquire) != dequeue_pos_ + 1) break;
+            Record &record = slot.record;
+            if (records != 0) joined.push_back('\n');
+            joined.append(record.keepalive ? record.borrowed : std::string_view(record.owned));
+            record.owned.clear();
+            record.keepalive.reset();
+            record.borrowed = {};
+            slot.seq.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+            ++dequeue_pos_;
+            ++records;
+        }
+
+        if (records != 0) {
+            lines.clear();
+            std::string_view rest(joined);
+            for (;;) {
+                const auto nl = rest.find('\n');
+                lines.push_back(rest.substr(0, nl));
+                if (nl == std::string_view::npos) break;
+                rest.remove_prefix(nl + 1);
+            }
+            if (options_.on_batch) options_.on_batch(lines, joined);
+            delivered_.store(dequeue_pos_, std::memory_order_seq_cst);
+            if (flush_waiters_.load(std::memory_order_seq_cst) != 0) delivered_.notify_all();
+            continue;
+        }
+
+        if (stop_requested_.load(std::memory_order_acquire)) {
+            // enqueue_pos_ is closed, but producers may still own a claimed-but-unpublished slot; wait for them.
+            if ((enqueue_pos_.load(std::memory_order_acquire) & ~kClosedBit) == dequeue_pos_) break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Park until a producer publishes, a flush is requested or stop is signalled.
+        const std::uint32_t observed = wake_seq_.load(std::memory_order_acquire);
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ring_empty() && !stop_requested_.load(std::memory_order_relaxed)) {
+            wake_seq_.wait(observed, std::memory_order_acquire);
+        }
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    delivered_.store(dequeue_pos_, std::memory_order_release);
+    delivered_.notify_all();
+    if (options_.on_thread_stop) options_.on_thread_stop();
+}
@@ -0,0 +1,85 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Multi-producer / single-consumer log pipeline.
+// Producers publish lines into a bounded ring of sequence-numbered slots without taking a lock. A single consumer
+// thread drains the ring and hands lines to the sink in batches, so file writes and JNI callbacks are paid once per
+// batch instead of once per line, and never on the producing thread.
+// A record is one or more '\n'-separated lines without a trailing newline. Its text is either owned by the record or
+// borrowed from a buffer kept alive by `keepalive`, which lets stream capture hand over lines without copying them on
+// the writing thread.
+class LogPipeline {
+public:
+    struct Options {
+        // Number of ring slots; rounded up to a power of two.
+        std::size_t capacity = 4096;
+        // Upper bound on records drained per on_batch call.
+        std::size_t max_batch_records = 512;
+        // Run on the consumer thread before the first / after the last batch (e.g. JNI attach/detach).
+        std::function<void()> on_thread_start;
+        std::function<void()> on_thread_stop;
+        // Receives the drained lines and the same lines joined with '\n' (no trailing newline). Line views point
+        // into joined, which is NUL-terminated and valid until the callback returns.
+        std::function<void(const std::vector<std::string_view> &lines, std::string_view joined)> on_batch;
+    };
+
+    LogPipeline() = default;
+    LogPipeline(const LogPipeline &) = delete;
+    LogPipeline &operator=(const LogPipeline &) = delete;
+    ~LogPipeline();
+
+    // Allocates the ring and starts the consumer thread. Returns false if already running.
+    bool start(Options options);
+    // Drains everything that was pushed and joins the consumer thread.
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    // Lock-free append. Spins (yielding) only while the ring is full. Returns false if the pipeline is not running.
+    bool push(std::string line);
+    // Borrowing variant (no copy on the producer side): text must stay valid while keepalive is referenced.
+    bool push(std::shared_ptr<const void> keepalive, std::string_view text);
+    // Blocks until every line pushed before this call has been handed to on_batch.
+    void flush();
+
+private:
+    struct Record {
+        std::string owned;
+        std::shared_ptr<const void> keepalive;
+        std::string_view borrowed;
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> seq{0};
+        Record record;
+    };
+
+    bool push_record(Record record);
+    void consumer_loop();
+    bool ring_empty() const noexcept;
+    void wake_consumer() noexcept;
+
+    Options options_;
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ = 0;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_requested_{false};
+
+    alignas(64) std::atomic<std::uint64_t> enqueue_pos_{0};
+    alignas(64) std::uint64_t dequeue_pos_ = 0; // consumer-owned
+    alignas(64) std::atomic<std::uint64_t> delivered_{0};
+    std::atomic<std::uint32_t> flush_waiters_{0};
+    // Consumer parking: producers only pay for a notify when the consumer is actually asleep.
+    alignas(64) std::atomic<std::uint32_t> wake_seq_{0};
+    std::atomic<bool> sleeping_{false};
+};
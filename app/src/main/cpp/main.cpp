@@ -4,6 +4,8 @@
 #include <jni.h>
 #include <coro/coro.hpp>
 
+#include <algorithm>
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -13,6 +15,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <thread>
 #include <atomic>
@@ -23,7 +26,14 @@
 #include <map>
 
 #include "../../../../external/libcoro/test/catch_amalgamated.hpp"
+#include "capture_streambuf.hpp"
+#include "log_pipeline.hpp"
+#include "test_metrics.hpp"
+#include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // Logging helpers
 #ifndef LOG_TAG
@@ -35,19 +45,12 @@
 
 using namespace coro;
 
-// JNI callback holder to append text into UI TextView.
-struct UiAppender {
-    JNIEnv* env = nullptr;
-    jobject activity = nullptr; // GlobalRef held outside
-    jclass activityClass = nullptr; // local
-    jmethodID appendMethod = nullptr; // void appendLine(String)
-};
-
-static std::mutex g_sink_mutex;
+static std::mutex g_log_file_mutex; // guards g_log_file between the log consumer and open/close in the runner
 static std::FILE* g_log_file = nullptr;
-static UiAppender g_ui{};
 static JavaVM* g_vm = nullptr;
 static jobject g_activity_global = nullptr; // GlobalRef to MainActivity
+static jmethodID g_append_line_mid = nullptr; // MainActivity.appendLine(String), cached once
+static JNIEnv* g_log_env = nullptr; // log consumer thread env, attached for the pipeline lifetime
 static std::mutex g_run_mutex; // serialize runs in-process
 static std::atomic<bool> g_session_used{false};
 static std::atomic<int> g_last_exit_code{-9999};
@@ -91,97 +94,94 @@ static std::vector<std::string> split_ws(const std::string& s) {
     return out;
 }
 
-static void ui_append_line(const char* line) {
-    std::lock_guard<std::mutex> lk(g_sink_mutex);
-    if (g_log_file) {
-        std::fputs(line, g_log_file);
-        std::fputc('\n', g_log_file);
-        std::fflush(g_log_file);
+// Runs on the log consumer thread: one buffered file write, logcat mirror and a single JNI call per batch.
+static void log_sink_batch(const std::vector<std::string_view>& lines, std::string_view joined) {
+    {
+        std::lock_guard<std::mutex> lk(g_log_file_mutex);
+        if (g_log_file) {
+            std::fwrite(joined.data(), 1, joined.size(), g_log_file);
+            std::fputc('\n', g_log_file);
+            std::fflush(g_log_file);
+        }
     }
     // Also mirror to logcat for CI visibility
-    LOGI("%s", line);
-    // Attach to JVM if needed to call back into UI
-    if (!g_vm || !g_activity_global) return;
-    JNIEnv* env = nullptr;
-    bool need_detach = false;
-    if (g_vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
-        if (g_vm->AttachCurrentThread(&env, nullptr) == JNI_OK) {
-            need_detach = true;
-        } else {
-            return;
-        }
+    for (const auto& line : lines) LOGI("%.*s", static_cast<int>(line.size()), line.data());
+    if (!g_log_env || !g_activity_global || !g_append_line_mid) return;
+    // joined views the whole consumer buffer, so it is NUL-terminated
+    jstring jstr = g_log_env->NewStringUTF(joined.data());
+    if (!jstr) { g_log_env->ExceptionClear(); return; }
+    g_log_env->CallVoidMethod(g_activity_global, g_append_line_mid, jstr);
+    if (g_log_env->ExceptionCheck()) g_log_env->ExceptionClear();
+    g_log_env->DeleteLocalRef(jstr);
+}
+
+// Process-lifetime pipeline; intentionally leaked so its JVM-attached thread is never torn down during exit.
+static LogPipeline& log_pipeline() {
+    static auto* pipeline = new LogPipeline();
+    return *pipeline;
+}
+
+static void start_log_pipeline() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        LogPipeline::Options opts;
+        opts.on_thread_start = [] {
+#if defined(__ANDROID__)
+            pthread_setname_np(pthread_self(), "coro-log");
+#endif
+            if (!g_vm || g_vm->AttachCurrentThread(&g_log_env, nullptr) != JNI_OK) g_log_env = nullptr;
+        };
+        opts.on_thread_stop = [] {
+            if (g_log_env) { g_vm->DetachCurrentThread(); g_log_env = nullptr; }
+        };
+        opts.on_batch = log_sink_batch;
+        log_pipeline().start(std::move(opts));
+    });
+}
+
+// Lock-free for producers; delivery to file/UI happens on the log consumer thread.
+static void ui_append_line(const char* line) {
+    if (!log_pipeline().push(std::string(line))) {
+        // Pipeline not started yet: logcat only
+        LOGI("%s", line);
     }
-    jclass cls = env->GetObjectClass(g_activity_global);
-    if (!cls) { if (need_detach) g_vm->DetachCurrentThread(); return; }
-    jmethodID mid = env->GetMethodID(cls, "appendLine", "(Ljava/lang/String;)V");
-    if (!mid) { if (need_detach) g_vm->DetachCurrentThread(); return; }
-    jstring jstr = env->NewStringUTF(line);
-    env->CallVoidMethod(g_activity_global, mid, jstr);
-    env->DeleteLocalRef(jstr);
-    env->DeleteLocalRef(cls);
-    if (need_detach) g_vm->DetachCurrentThread();
 }
 
-// Minimal Catch2 listener that forwards stdout/stderr:
-// We will redirect std::cout/cerr rdbuf to our sink so Catch's console reporter prints into UI and file.
+// Swap the log file once everything queued so far has reached the previous one.
+static void set_log_file(std::FILE* f) {
+    log_pipeline().flush();
+    std::lock_guard<std::mutex> lk(g_log_file_mutex);
+    if (g_log_file) std::fclose(g_log_file);
+    g_log_file = f;
+    if (g_log_file) std::setvbuf(g_log_file, nullptr, _IOFBF, 64 * 1024);
+}
+
+// Capture std::cout/std::cerr so Catch's console reporter prints into UI and file.
+// Completed lines go straight from the capture chunks into the log pipeline, whose consumer wakes only when data
+// arrives; there is no polling flusher. Buffers live for the whole process because a runner thread detached on
+// timeout may still be writing to them.
+static CaptureStreambuf& capture_buf(std::ostream& os) {
+    static auto publish = [](std::shared_ptr<const void> chunk, std::string_view lines) {
+        if (!log_pipeline().push(std::move(chunk), lines)) LOGI("%.*s", static_cast<int>(lines.size()), lines.data());
+    };
+    static auto* out = new CaptureStreambuf(publish);
+    static auto* err = new CaptureStreambuf(publish);
+    return &os == &std::cerr ? *err : *out;
+}
+
 class StreamRedirector {
 public:
-    explicit StreamRedirector(std::ostream& os): os_(os), old_(os.rdbuf()) {
-        os_.rdbuf(buf_.rdbuf());
-    }
+    explicit StreamRedirector(std::ostream& os): os_(os), buf_(capture_buf(os)), old_(os.rdbuf(&buf_)) {}
     ~StreamRedirector() {
         os_.rdbuf(old_);
+        buf_.drain();
     }
-    void flush_to_ui() {
-        std::string s = buf_.str();
-        size_t start = 0;
-        while (start < s.size()) {
-            auto pos = s.find('\n', start);
-            std::string line = s.substr(start, pos == std::string::npos ? std::string::npos : pos - start);
-            if (!line.empty()) ui_append_line(line.c_str());
-            if (pos == std::string::npos) break;
-            start = pos + 1;
-        }
-        buf_.str("");
-        buf_.clear();
-    }
+    // Hand over a trailing partial line before the log file is closed.
+    void drain() { buf_.drain(); }
 private:
     std::ostream& os_;
+    CaptureStreambuf& buf_;
     std::streambuf* old_;
-    std::stringstream buf_;
-};
-
-// Periodically flush redirected streams into UI/log to avoid blank screen and provide live progress.
-class PeriodicFlusher {
-public:
-    PeriodicFlusher(StreamRedirector& out, StreamRedirector& err)
-        : out_(out), err_(err) {}
-    void start(std::chrono::milliseconds interval = std::chrono::milliseconds(200)) {
-        if (running_.exchange(true)) return;
-        th_ = std::thread([this, interval]{
-            // Attach a name for debugging
-#if defined(__ANDROID__)
-            pthread_setname_np(pthread_self(), "coro-flusher");
-#endif
-            while (running_.load()) {
-                out_.flush_to_ui();
-                err_.flush_to_ui();
-                std::this_thread::sleep_for(interval);
-            }
-        });
-    }
-    void stop() {
-        if (!running_.exchange(false)) return;
-        if (th_.joinable()) th_.join();
-        // Final flush to drain any remaining content
-        out_.flush_to_ui();
-        err_.flush_to_ui();
-    }
-private:
-    std::atomic<bool> running_{false};
-    std::thread th_;
-    StreamRedirector& out_;
-    StreamRedirector& err_;
 };
 
 // In-process runner for libcoro tests using Catch2 main. We cannot include test main TU, so we emulate CLI.
@@ -190,61 +190,310 @@ private:
 // Forward declare Catch2 Session to avoid including huge amalgamation here again; tests already include it.
 namespace Catch { class Session; }
 
-// Contract: run_all_tests executes Catch2 test session and returns exit code; it must not throw.
-static int run_all_tests_with_output(const std::string& files_dir) noexcept {
-    // Ensure we never construct Catch::Session more than once per process.
-    if (g_session_used.load(std::memory_order_acquire)) {
-        int last = g_last_exit_code.load(std::memory_order_relaxed);
-        ui_append_line("Tests already executed in this process. Skipping.");
-        if (last == -9999) last = 1; // unknown previous state -> treat as failure
-        return last;
+// Parse a positive integer property; returns fallback when missing or out of range.
+static long parse_long_property(const std::string& value, long fallback, long max_value) {
+    if (value.empty()) return fallback;
+    char* endp = nullptr;
+    long v = std::strtol(value.c_str(), &endp, 10);
+    if (endp != value.c_str() && v > 0 && v < max_value) return v;
+    return fallback;
+}
+
+// Runs one Catch2 session over the linked test registry. Errors are reported on std::cerr, which is captured in
+// in-process mode and piped to the parent in shard mode (a shard child must never touch JNI or the log pipeline).
+static int run_catch_session(const std::vector<const char*>& argv, unsigned shard_count, unsigned shard_index) {
+    try {
+        Catch::Session session; // uses global registry linked from tests
+        session.configData().benchmarkNoAnalysis = true; // speed on mobile
+        session.configData().showDurations = Catch::ShowDurations::Always;
+        session.configData().shardCount = shard_count;
+        session.configData().shardIndex = shard_index;
+        int rc = session.applyCommandLine(static_cast<int>(argv.size()), argv.data());
+        if (rc != 0) return rc;
+        return session.run();
+    } catch (const std::exception& ex) {
+        std::cerr << "Exception in test runner: " << ex.what() << std::endl;
+        return 3;
+    } catch (...) {
+        std::cerr << "Unknown exception in test runner" << std::endl;
+        return 4;
+    }
+}
+
+// In-process mode: single Catch2 session on a separate thread with a global timeout. Can run once per process.
+static int run_in_process(const std::vector<const char*>& argv, std::chrono::seconds global_timeout) {
+    // Redirect std::cout and std::cerr; Catch prints there by default.
+    StreamRedirector out(std::cout);
+    StreamRedirector err(std::cerr);
+
+    int code = 2;
+    std::packaged_task<int()> task([argv] { return run_catch_session(argv, 1, 0); });
+    auto fut = task.get_future();
+    std::thread t(std::move(task));
+
+    // Global timeout for the entire Catch2 run; emulator can be slow.
+    ui_append_line((std::string("Global timeout: ") + std::to_string(global_timeout.count()) + "s").c_str());
+    if (fut.wait_for(global_timeout) == std::future_status::ready) {
+        code = fut.get();
+        t.join();
+    } else {
+        ui_append_line("Global timeout reached, detaching test runner thread...");
+        code = 124; // timeout
+        t.detach(); // Let OS reap the thread when process exits
+    }
+    g_session_used.store(true, std::memory_order_release);
+    // Hand over any trailing partial lines
+    out.drain();
+    err.drain();
+    return code;
+}
+
+struct ShardProcess {
+    unsigned index = 0;
+    pid_t pid = -1;
+    int fd = -1; // read end of the child's stdout/stderr pipe
+    std::string partial; // incomplete trailing line read from fd
+    std::chrono::steady_clock::time_point started;
+    bool exited = false;
+    bool timed_out = false;
+    int code = 2;
+};
+
+static std::string shard_metrics_path(const std::string& metrics_path, unsigned index) {
+    return metrics_path + ".shard" + std::to_string(index);
+}
+
+// Forks a child that runs one Catch2 shard with stdout/stderr connected to a pipe. Returns false on failure.
+static bool spawn_shard(
+    const std::vector<const char*>& argv, unsigned shard_count, const std::string& metrics_path, ShardProcess& shard) {
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) != 0) return false;
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    // Hazard: this forks the app process, i.e. a JVM with many threads. Only the forking thread exists in the child,
+    // so a lock held by any other thread at fork time (JVM internals, g_log_file_mutex, the log pipeline) stays held
+    // forever, and POSIX only allows async-signal-safe calls until exec. The child still runs a full Catch2 session,
+    // which allocates and starts threads. That relies on the C library allocator and stdio staying usable after
+    // fork(), which is true for bionic and glibc because they reset their locks in the child. The child must never
+    // touch JNI, the log pipeline or the capture streambufs: it writes only to the pipe and leaves with _exit(), so no
+    // JVM or static teardown runs. A child that deadlocks anyway is killed by the per-shard timeout. Exec'ing a
+    // separate test binary would remove the hazard, but the APK ships the tests only as this JNI library.
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        // Child: only the forking thread exists. Isolated global state for io_scheduler/tcp_server tests.
+        dup2(fds[1], STDOUT_FILENO);
+        dup2(fds[1], STDERR_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        std::setvbuf(stdout, nullptr, _IOLBF, 0);
+        signal(SIGPIPE, SIG_IGN);
+        test_metrics_set_output(shard_metrics_path(metrics_path, shard.index));
+        int rc = run_catch_session(argv, shard_count, shard.index);
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+        _exit(rc > 255 ? 255 : rc);
+    }
+    close(fds[1]);
+    shard.pid = pid;
+    shard.fd = fds[0];
+    shard.started = std::chrono::steady_clock::now();
+    return true;
+}
+
+// Forward complete lines from a shard pipe into the merged log, tagged with the shard index.
+static void forward_shard_output(ShardProcess& shard, const std::string& tag, const char* data, size_t n, bool eof) {
+    shard.partial.append(data, n);
+    size_t start = 0;
+    for (;;) {
+        auto pos = shard.partial.find('\n', start);
+        if (pos == std::string::npos) break;
+        ui_append_line((tag + shard.partial.substr(start, pos - start)).c_str());
+        start = pos + 1;
+    }
+    shard.partial.erase(0, start);
+    if (eof && !shard.partial.empty()) {
+        ui_append_line((tag + shard.partial).c_str());
+        shard.partial.clear();
+    }
+}
+
+// Supervision failed: SIGKILL every shard still running, reap it and close its pipe, so no zombie process or fd is
+// left behind in the app process. Output still buffered in a pipe is dropped.
+static void abort_shards(std::vector<ShardProcess>& shards) {
+    for (auto& shard : shards) {
+        if (!shard.exited) {
+            kill(shard.pid, SIGKILL);
+            int status = 0;
+            while (waitpid(shard.pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            shard.exited = true;
+            shard.code = 128 + SIGKILL;
+        }
+        if (shard.fd >= 0) {
+            forward_shard_output(shard, "[shard " + std::to_string(shard.index) + "] ", nullptr, 0, true);
+            close(shard.fd);
+            shard.fd = -1;
+        }
+    }
+}
+
+// Shard mode: N child processes each run 1/N of the selected tests concurrently; output and exit codes are merged.
+static int run_sharded(const std::vector<const char*>& argv, unsigned shard_count, std::chrono::seconds shard_timeout,
+    const std::string& metrics_path) {
+    ui_append_line((std::string("Running ") + std::to_string(shard_count)
+        + " shards in child processes, per-shard timeout: " + std::to_string(shard_timeout.count()) + "s").c_str());
+    std::vector<ShardProcess> shards(shard_count);
+    for (unsigned i = 0; i < shard_count; ++i) {
+        shards[i].index = i;
+        if (!spawn_shard(argv, shard_count, metrics_path, shards[i])) {
+            ui_append_line(
+                (std::string("Failed to start shard ") + std::to_string(i) + ": " + std::strerror(errno)).c_str());
+            shards[i].exited = true;
+            shards[i].code = 5;
+        }
+    }
+
+    std::vector<char> buf(64 * 1024);
+    std::vector<pollfd> pfds;
+    std::vector<ShardProcess*> polled;
+    bool supervision_failed = false;
+    for (;;) {
+        pfds.clear();
+        polled.clear();
+        bool pending = false;
+        for (auto& shard : shards) {
+            if (shard.fd >= 0) {
+                pfds.push_back(pollfd{shard.fd, POLLIN, 0});
+                polled.push_back(&shard);
+            }
+            if (shard.fd >= 0 || !shard.exited) pending = true;
+        }
+        if (!pending) break;
+
+        // Wake on output; the short timeout only bounds how late reaping and timeout checks can happen.
+        if (!pfds.empty()) {
+            int n = poll(pfds.data(), pfds.size(), 100);
+            if (n < 0 && errno != EINTR) {
+                ui_append_line((std::string("poll() on shard output failed: ") + std::strerror(errno)
+                    + ", killing remaining shards").c_str());
+                abort_shards(shards);
+                supervision_failed = true;
+                break;
+            }
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        for (size_t i = 0; i < pfds.size(); ++i) {
+            if (!(pfds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            ShardProcess& shard = *polled[i];
+            const std::string tag = "[shard " + std::to_string(shard.index) + "] ";
+            ssize_t r = read(shard.fd, buf.data(), buf.size());
+            if (r < 0 && errno == EINTR) continue;
+            if (r > 0) {
+                forward_shard_output(shard, tag, buf.data(), static_cast<size_t>(r), false);
+            } else {
+                forward_shard_output(shard, tag, nullptr, 0, true);
+                close(shard.fd);
+                shard.fd = -1;
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        for (auto& shard : shards) {
+            if (shard.exited) continue;
+            int status = 0;
+            pid_t r = waitpid(shard.pid, &status, WNOHANG);
+            if (r == shard.pid) {
+                shard.exited = true;
+                if (shard.timed_out) {
+                    shard.code = 124;
+                } else if (WIFEXITED(status)) {
+                    shard.code = WEXITSTATUS(status);
+                } else if (WIFSIGNALED(status)) {
+                    shard.code = 128 + WTERMSIG(status);
+                }
+                auto secs = std::chrono::duration_cast<std::chrono::seconds>(now - shard.started).count();
+                ui_append_line((std::string("Shard ") + std::to_string(shard.index) + "/" + std::to_string(shard_count)
+                    + " finished with code " + std::to_string(shard.code) + " after " + std::to_string(secs) + "s")
+                        .c_str());
+            } else if (!shard.timed_out && now - shard.started > shard_timeout) {
+                ui_append_line((std::string("Shard ") + std::to_string(shard.index) + " timed out, killing pid "
+                    + std::to_string(shard.pid)).c_str());
+                shard.timed_out = true;
+                kill(shard.pid, SIGKILL);
+            }
+        }
+    }
+
+    // Merge per-shard metrics (rows of a killed shard up to its last finished test are kept).
+    std::remove(metrics_path.c_str());
+    for (auto& shard : shards) {
+        test_metrics_merge(metrics_path, shard_metrics_path(metrics_path, shard.index));
     }
+
+    // Merged exit code: 0 only if every shard passed, otherwise the first failing shard's code. A run whose
+    // supervision failed is never reported as passed, even when every shard it waited for had passed.
+    for (auto& shard : shards) {
+        if (shard.code != 0) return shard.code;
+    }
+    return supervision_failed ? 5 : 0;
+}
+
+// Contract: run_all_tests executes Catch2 test session(s) and returns exit code; it must not throw.
+static int run_all_tests_with_output(const std::string& files_dir) noexcept {
     std::unique_lock<std::mutex> run_lk(g_run_mutex);
+    // Allow override via properties file located in files_dir
+    // File format (properties):
+    //   filter=<Catch2 test specs separated by spaces>
+    //   timeout=<seconds>
+    //   shards=<N|auto>         run N shards in parallel child processes (default 1: in-process)
+    //   shard_timeout=<seconds> per-shard timeout in shard mode (default: timeout)
+    std::map<std::string, std::string> props;
+    try {
+        props = read_properties_file(files_dir + "/coro_test_config.properties");
+    } catch (...) {
+    }
+    unsigned shard_count = 1;
+    if (props["shards"] == "auto") {
+        shard_count = std::max(1u, std::thread::hardware_concurrency());
+    } else {
+        shard_count = static_cast<unsigned>(parse_long_property(props["shards"], 1, 256));
+    }
+
+    // Ensure we never construct Catch::Session more than once per process. Only in-process runs set g_session_used:
+    // in shard mode the parent never constructs a session, and each child constructs its own in a fresh copy of the
+    // process, so a sharded run can be repeated.
     if (g_session_used.load(std::memory_order_acquire)) {
         int last = g_last_exit_code.load(std::memory_order_relaxed);
         ui_append_line("Tests already executed in this process. Skipping.");
-        if (last == -9999) last = 1;
+        if (last == -9999) last = 1; // unknown previous state -> treat as failure
         return last;
     }
     // Prevent SIGPIPE from killing the process during networking tests
     signal(SIGPIPE, SIG_IGN);
     // Open log file under app's files dir
     const std::string log_path = files_dir + "/libcoro-tests.log";
-    {
-        std::lock_guard<std::mutex> lk(g_sink_mutex);
-        if (g_log_file) { std::fclose(g_log_file); g_log_file = nullptr; }
-        g_log_file = std::fopen(log_path.c_str(), "w");
-    }
-
-    // Redirect std::cout and std::cerr; Catch prints there by default.
-    StreamRedirector out(std::cout);
-    StreamRedirector err(std::cerr);
+    set_log_file(std::fopen(log_path.c_str(), "w"));
 
     // Proactive line to avoid empty UI at start
     ui_append_line("Starting libcoro tests...");
-    // Periodically flush output while tests are running
-    PeriodicFlusher flusher(out, err);
-    flusher.start(std::chrono::milliseconds(150));
 
     int code = 2; // non-zero by default
     try {
-        // Allow override via properties file located in files_dir
-        // File format (properties):
-        //   filter=<Catch2 test specs separated by spaces>
-        //   timeout=<seconds>
-        const std::string props_path = files_dir + "/coro_test_config.properties";
-        auto props = read_properties_file(props_path);
-
         // Determine global timeout
-        constexpr auto kDefaultGlobalTimeout = std::chrono::seconds(600);
-        std::chrono::seconds global_timeout = kDefaultGlobalTimeout;
-        if (!props["timeout"].empty()) {
-            char* endp = nullptr;
-            long v = std::strtol(props["timeout"].c_str(), &endp, 10);
-            if (endp != props["timeout"].c_str() && v > 0 && v < 24 * 60 * 60) {
-                global_timeout = std::chrono::seconds(v);
-            }
-        }
+        constexpr long kDefaultGlobalTimeoutSec = 600;
+        constexpr long kMaxTimeoutSec = 24 * 60 * 60;
+        const std::chrono::seconds global_timeout(
+            parse_long_property(props["timeout"], kDefaultGlobalTimeoutSec, kMaxTimeoutSec));
+        const std::chrono::seconds shard_timeout(
+            parse_long_property(props["shard_timeout"], global_timeout.count(), kMaxTimeoutSec));
 
         std::vector<std::string> filter_tokens;
         if (!props["filter"].empty()) {
@@ -272,39 +521,13 @@ static int run_all_tests_with_output(const std::string& files_dir) noexcept {
             ui_append_line("Using default test excludes suitable for emulator.");
         }
 
-        // Run Catch2 session on a separate thread and enforce a global timeout.
-    auto runner = [argv]() -> int {
-            try {
-                Catch::Session session; // uses global registry linked from tests
-                session.configData().benchmarkNoAnalysis = true; // speed on mobile
-                session.configData().showDurations = Catch::ShowDurations::Always;
-                session.configData().shardCount = 1;
-                session.configData().shardIndex = 0;
-                int rc = session.applyCommandLine(static_cast<int>(argv.size()), argv.data());
-                if (rc != 0) return rc;
-                return session.run();
-            } catch (const std::exception& ex) {
-                ui_append_line((std::string("Exception in test runner: ") + ex.what()).c_str());
-                return 3;
-            } catch (...) {
-                ui_append_line("Unknown exception in test runner");
-                return 4;
-            }
-        };
-
-        std::packaged_task<int()> task(runner);
-        auto fut = task.get_future();
-        std::thread t(std::move(task));
-
-    // Global timeout for the entire Catch2 run; emulator can be slow.
-    ui_append_line((std::string("Global timeout: ") + std::to_string(global_timeout.count()) + "s").c_str());
-    if (fut.wait_for(global_timeout) == std::future_status::ready) {
-            code = fut.get();
-            t.join();
+        // Per-test CPU/RSS/allocation/thread metrics next to the log
+        const std::string metrics_path = files_dir + "/libcoro-tests-metrics.csv";
+        if (shard_count > 1) {
+            code = run_sharded(argv, shard_count, shard_timeout, metrics_path);
         } else {
-            ui_append_line("Global timeout reached, detaching test runner thread...");
-            code = 124; // timeout
-            t.detach(); // Let OS reap the thread when process exits
+            test_metrics_set_output(metrics_path);
+            code = run_in_process(argv, global_timeout);
         }
     } catch (const std::exception& e) {
         ui_append_line((std::string("Exception: ") + e.what()).c_str());
@@ -313,14 +536,8 @@ static int run_all_tests_with_output(const std::string& files_dir) noexcept {
         ui_append_line("Unknown exception");
         code = 4;
     }
-    // Stop flusher and perform one last flush
-    flusher.stop();
 
-    {
-        std::lock_guard<std::mutex> lk(g_sink_mutex);
-        if (g_log_file) { std::fclose(g_log_file); g_log_file = nullptr; }
-    }
-    g_session_used.store(true, std::memory_order_release);
+    set_log_file(nullptr);
     g_last_exit_code.store(code, std::memory_order_relaxed);
     run_lk.unlock();
     return code;
@@ -353,7 +570,12 @@ extern "C" JNIEXPORT jint JNICALL Java_com_example_libcorotest_MainActivity_runT
     // Save GlobalRef to activity for callbacks
     if (!g_activity_global) {
         g_activity_global = env->NewGlobalRef(thiz);
+        jclass cls = env->GetObjectClass(thiz);
+        g_append_line_mid = env->GetMethodID(cls, "appendLine", "(Ljava/lang/String;)V");
+        if (!g_append_line_mid) env->ExceptionClear();
+        env->DeleteLocalRef(cls);
     }
+    start_log_pipeline();
     const char* cpath = env->GetStringUTFChars(filesDir, nullptr);
     std::string files_dir = cpath ? cpath : std::string{};
     env->ReleaseStringUTFChars(filesDir, cpath);
@@ -369,5 +591,6 @@ extern "C" JNIEXPORT jint JNICALL Java_com_example_libcorotest_MainActivity_runT
     int rc = run_all_tests_with_output(files_dir);
     ui_append_line((std::string("Exit code: ") + std::to_string(rc)).c_str());
     ui_append_line((std::string("Tests completed with exit code: ") + std::to_string(rc)).c_str());
+    log_pipeline().flush();
     return static_cast<jint>(rc);
 }
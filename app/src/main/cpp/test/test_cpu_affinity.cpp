@@ -0,0 +1,103 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/cpu_affinity.hpp"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using coro_ext::cpu_info;
+using coro_ext::cpu_placement;
+using coro_ext::cpu_topology;
+
+cpu_info by_capacity(int id, std::uint32_t capacity, int package = 0) {
+    return cpu_info{.id = id, .capacity = capacity, .max_freq_khz = 0, .package = package};
+}
+
+cpu_info by_frequency(int id, std::uint32_t max_freq_khz, int package = 0) {
+    return cpu_info{.id = id, .capacity = 0, .max_freq_khz = max_freq_khz, .package = package};
+}
+
+} // namespace
+
+TEST_CASE("cpu_topology excludes only the slowest core type", "[coro_ext][cpu_affinity]") {
+    SECTION("prime, big and little cores") {
+        // Capacities as reported on a 1 + 3 + 4 SoC: the big cores differ slightly from each other.
+        const cpu_topology topology{{by_capacity(0, 250), by_capacity(1, 250), by_capacity(2, 248), by_capacity(3, 250),
+                                     by_capacity(4, 871), by_capacity(5, 871), by_capacity(6, 860),
+                                     by_capacity(7, 1024)}};
+        CHECK(topology.heterogeneous());
+        CHECK(topology.performance_cpus() == std::vector<int>{4, 5, 6, 7});
+        CHECK(topology.resolve(cpu_placement{.kind = cpu_placement::policy::performance_cores}) ==
+              std::vector<int>{4, 5, 6, 7});
+    }
+
+    SECTION("capacities within the tolerance are one type") {
+        const cpu_topology topology{{by_capacity(0, 1024), by_capacity(1, 1015), by_capacity(2, 1020)}};
+        CHECK_FALSE(topology.heterogeneous());
+        CHECK(topology.performance_cpus() == std::vector<int>{0, 1, 2});
+    }
+
+    SECTION("maximum frequency when a CPU lacks cpu_capacity") {
+        std::vector<cpu_info> cpus{by_frequency(0, 1'804'800), by_frequency(1, 1'804'800),
+                                   by_frequency(2, 2'419'200), by_frequency(3, 2'841'600)};
+        cpus[2].capacity = 1024; // ignored: not every CPU exports it
+        const cpu_topology topology{cpus};
+        CHECK(topology.heterogeneous());
+        CHECK(topology.performance_cpus() == std::vector<int>{2, 3});
+    }
+
+    SECTION("no ranking attributes") {
+        const cpu_topology topology{{by_frequency(0, 0), by_frequency(1, 0)}};
+        CHECK_FALSE(topology.heterogeneous());
+        CHECK(topology.performance_cpus() == std::vector<int>{0, 1});
+    }
+}
+
+TEST_CASE("cpu_topology resolves placements", "[coro_ext][cpu_affinity]") {
+    // Two packages of identical cores: one cluster is the package of the lowest-numbered CPU.
+    const cpu_topology topology{{by_capacity(0, 1024, 0), by_capacity(1, 1024, 1), by_capacity(2, 1024, 0),
+                                 by_capacity(3, 1024, 1)}};
+    CHECK(topology.resolve(cpu_placement{}).empty());
+    CHECK(topology.performance_cluster() == std::vector<int>{0, 2});
+    CHECK(topology.resolve(cpu_placement{.kind = cpu_placement::policy::performance_cluster}) ==
+          std::vector<int>{0, 2});
+    // Explicit CPUs keep their order; duplicates and CPUs outside the topology are dropped.
+    CHECK(topology.resolve(cpu_placement{.kind = cpu_placement::policy::cpus, .cpus = {3, 9, 1, 3}}) ==
+          std::vector<int>{3, 1});
+}
+
+TEST_CASE("cpu_topology reads sysfs attributes", "[coro_ext][cpu_affinity]") {
+    const auto root = std::filesystem::temp_directory_path() / ("cpu_affinity_test_" + std::to_string(::getpid()));
+    const std::vector<int> allowed = cpu_topology::detect(root.string()).all_cpus();
+    REQUIRE_FALSE(allowed.empty());
+    for (std::size_t i = 0; i < allowed.size(); ++i) {
+        const auto dir = root / ("cpu" + std::to_string(allowed[i]));
+        std::filesystem::create_directories(dir / "cpufreq");
+        std::filesystem::create_directories(dir / "topology");
+        // The first allowed CPU is the only little core.
+        std::ofstream{dir / "cpu_capacity"} << (i == 0 ? 300 : 1024) << "\n";
+        std::ofstream{dir / "cpufreq" / "cpuinfo_max_freq"} << 2'000'000 << "\n";
+        std::ofstream{dir / "topology" / "physical_package_id"} << 0 << "\n";
+    }
+
+    const cpu_topology topology = cpu_topology::detect(root.string());
+    std::filesystem::remove_all(root);
+    REQUIRE(topology.cpus().size() == allowed.size());
+    CHECK(topology.cpus().front().capacity == 300);
+    CHECK(topology.cpus().front().max_freq_khz == 2'000'000);
+    if (allowed.size() > 1) {
+        CHECK(topology.heterogeneous());
+        CHECK(topology.performance_cpus() == std::vector<int>(allowed.begin() + 1, allowed.end()));
+    } else {
+        CHECK(topology.performance_cpus() == allowed);
+    }
+}
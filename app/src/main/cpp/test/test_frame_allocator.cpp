@@ -0,0 +1,143 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/frame_allocator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using coro_ext::frame_allocator;
+
+// Sizes at and around every size class boundary, plus one above max_pooled_size.
+constexpr std::array<std::size_t, 16> kSizes{1,   16,  17,   100,  511,  512,  513,  1000,
+                                             1024, 1025, 1536, 1537, 2048, 3072, 4096, 4097};
+
+struct block {
+    unsigned char *ptr;
+    std::size_t size;
+};
+
+// Fills each block with its own byte pattern, so overlapping blocks show up when the patterns are checked.
+void fill(const std::vector<block> &blocks) {
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+        std::memset(blocks[i].ptr, static_cast<int>(i & 0xff), blocks[i].size);
+}
+
+bool intact(const std::vector<block> &blocks) {
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        const auto expected = static_cast<unsigned char>(i & 0xff);
+        const auto matches = [expected](unsigned char c) { return c == expected; };
+        if (!std::all_of(blocks[i].ptr, blocks[i].ptr + blocks[i].size, matches)) return false;
+    }
+    return true;
+}
+
+std::vector<block> allocate_each(std::size_t rounds) {
+    std::vector<block> blocks;
+    for (std::size_t r = 0; r < rounds; ++r) {
+        for (const std::size_t size : kSizes)
+            blocks.push_back({static_cast<unsigned char *>(frame_allocator::allocate(size)), size});
+    }
+    return blocks;
+}
+
+void deallocate_all(std::vector<block> &blocks) {
+    for (const auto &b : blocks) frame_allocator::deallocate(b.ptr, b.size);
+    blocks.clear();
+}
+
+} // namespace
+
+TEST_CASE("frame_allocator hands out aligned, disjoint blocks in every size class", "[coro_ext][frame_allocator]") {
+    std::thread{[] {
+        auto blocks = allocate_each(300);
+        bool aligned = true;
+        for (const auto &b : blocks) aligned = aligned && reinterpret_cast<std::uintptr_t>(b.ptr) % 16 == 0;
+        CHECK(aligned);
+        fill(blocks);
+        CHECK(intact(blocks));
+        deallocate_all(blocks);
+    }}.join();
+}
+
+TEST_CASE("frame_allocator reuses freed blocks of the same size class", "[coro_ext][frame_allocator]") {
+    std::thread{[] {
+        for (const std::size_t size : kSizes) {
+            if (size > frame_allocator::max_pooled_size) continue;
+            void *first = frame_allocator::allocate(size);
+            frame_allocator::deallocate(first, size);
+            // Same thread, same class: the block just freed comes back (LIFO), even for a different size in the class.
+            void *second = frame_allocator::allocate(size == 1 ? 16 : size);
+            CHECK(second == first);
+            frame_allocator::deallocate(second, size == 1 ? 16 : size);
+        }
+        // A steady allocate/free cycle reserves no new chunks.
+        auto warm = allocate_each(50);
+        deallocate_all(warm);
+        const std::size_t reserved = frame_allocator::reserved_bytes();
+        for (int i = 0; i < 20; ++i) {
+            auto blocks = allocate_each(50);
+            deallocate_all(blocks);
+        }
+        CHECK(frame_allocator::reserved_bytes() == reserved);
+    }}.join();
+}
+
+TEST_CASE("frame_allocator blocks freed on another thread are recycled", "[coro_ext][frame_allocator]") {
+    constexpr std::size_t kBlocks = 20'000;
+    constexpr std::size_t kSize = 96;
+    std::size_t reserved_after_first = 0;
+    std::thread{[&] {
+        for (int round = 0; round < 10; ++round) {
+            std::vector<block> blocks;
+            for (std::size_t i = 0; i < kBlocks; ++i)
+                blocks.push_back({static_cast<unsigned char *>(frame_allocator::allocate(kSize)), kSize});
+            fill(blocks);
+            REQUIRE(intact(blocks));
+            // Freed on another thread: its lists spill to the shared pool, which this thread refills from.
+            std::thread{[&blocks] { deallocate_all(blocks); }}.join();
+            if (round == 0) reserved_after_first = frame_allocator::reserved_bytes();
+        }
+        // Later rounds reuse the first round's blocks instead of carving new chunks (a few chunks of slack for
+        // blocks still cached by the threads).
+        CHECK(frame_allocator::reserved_bytes() <= reserved_after_first + 4 * frame_allocator::chunk_size);
+    }}.join();
+}
+
+TEST_CASE("frame_allocator trim returns unused chunks", "[coro_ext][frame_allocator]") {
+    // Every allocation happens on short-lived threads, so their chunks are retired by the time trim() runs.
+    frame_allocator::trim();
+    const std::size_t before = frame_allocator::reserved_bytes();
+    std::vector<block> survivors;
+    std::thread{[&survivors] {
+        auto blocks = allocate_each(200);
+        // One live block keeps its chunk; the others are freed before the thread exits.
+        survivors.push_back(blocks[5]);
+        blocks.erase(blocks.begin() + 5);
+        deallocate_all(blocks);
+    }}.join();
+    const std::size_t grown = frame_allocator::reserved_bytes() - before;
+    REQUIRE(grown > 2 * frame_allocator::chunk_size);
+
+    CHECK(frame_allocator::trim() == grown - frame_allocator::chunk_size);
+    CHECK(frame_allocator::reserved_bytes() == before + frame_allocator::chunk_size);
+
+    std::thread{[&survivors] {
+        // The kept chunk's free blocks are still handed out, next to the survivor.
+        auto blocks = allocate_each(1);
+        blocks.push_back(survivors.front());
+        fill(blocks);
+        CHECK(intact(blocks));
+        deallocate_all(blocks);
+    }}.join();
+    frame_allocator::trim();
+    CHECK(frame_allocator::reserved_bytes() <= before);
+}
@@ -0,0 +1,252 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/mpmc_ring_buffer.hpp"
+
+#include <coro/coro.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+template <typename ring>
+coro::task<bool> produce_one(ring &rb, std::uint64_t value) {
+    co_return co_await rb.produce(value);
+}
+
+template <typename ring>
+coro::task<std::optional<std::uint64_t>> consume_one(ring &rb) {
+    co_return co_await rb.consume();
+}
+
+template <typename ring>
+coro::task<std::size_t> produce_all(ring &rb, std::vector<std::uint64_t> &items) {
+    co_return co_await rb.produce_batch(std::span{items});
+}
+
+template <typename ring>
+coro::task<std::size_t> consume_some(ring &rb, std::vector<std::uint64_t> &out) {
+    co_return co_await rb.consume_batch(std::span{out});
+}
+
+// Produces [begin, end), alternating single and batched produce; stops early if the buffer shuts down. Returns the
+// number of elements the buffer accepted.
+template <typename ring>
+coro::task<std::uint64_t> producer(ring &rb, std::uint64_t begin, std::uint64_t end) {
+    std::uint64_t accepted = 0;
+    std::vector<std::uint64_t> batch;
+    for (std::uint64_t v = begin; v < end;) {
+        if ((v / 7) % 2 == 0) {
+            if (!co_await rb.produce(v)) co_return accepted;
+            ++accepted;
+            ++v;
+        } else {
+            batch.clear();
+            for (std::uint64_t i = 0; i < 5 && v + i < end; ++i) batch.push_back(v + i);
+            const std::size_t n = co_await rb.produce_batch(std::span{batch});
+            accepted += n;
+            if (n < batch.size()) co_return accepted;
+            v += n;
+        }
+    }
+    co_return accepted;
+}
+
+struct consumed {
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::vector<std::uint64_t> values;
+};
+
+// Consumes until the buffer is shut down and drained, alternating single and batched consume.
+template <typename ring>
+coro::task<consumed> consumer(ring &rb) {
+    consumed result;
+    std::vector<std::uint64_t> out(6);
+    for (bool batched = false;; batched = !batched) {
+        if (batched) {
+            const std::size_t n = co_await rb.consume_batch(std::span{out});
+            if (n == 0) break;
+            for (std::size_t i = 0; i < n; ++i) result.values.push_back(out[i]);
+        } else {
+            auto value = co_await rb.consume();
+            if (!value) break;
+            result.values.push_back(*value);
+        }
+    }
+    for (const auto v : result.values) result.sum += v;
+    result.count = result.values.size();
+    co_return result;
+}
+
+} // namespace
+
+TEST_CASE("mpmc_ring_buffer keeps FIFO order across many laps", "[coro_ext][mpmc_ring_buffer]") {
+    coro_ext::mpmc_ring_buffer<std::uint64_t, 4> rb;
+    std::uint64_t next_in = 0;
+    std::uint64_t next_out = 0;
+    for (int step = 0; step < 5000; ++step) {
+        // Fill levels sweep 0..4 so positions wrap at every offset.
+        const int fill = step % 5;
+        for (int i = 0; i < fill; ++i) {
+            std::uint64_t v = next_in;
+            if (rb.try_produce(v)) ++next_in;
+        }
+        REQUIRE(rb.size() == next_in - next_out);
+        std::uint64_t v = next_in;
+        if (next_in - next_out == rb.capacity()) REQUIRE_FALSE(rb.try_produce(v));
+        while (auto value = rb.try_consume()) {
+            REQUIRE(*value == next_out);
+            ++next_out;
+        }
+        REQUIRE(rb.empty());
+    }
+    REQUIRE(next_out == next_in);
+    REQUIRE(next_in > 4 * 1000);
+}
+
+TEST_CASE("mpmc_ring_buffer batches claim partial runs", "[coro_ext][mpmc_ring_buffer]") {
+    coro_ext::mpmc_ring_buffer<std::uint64_t, 8> rb;
+    for (std::uint64_t v = 100; v < 105; ++v) REQUIRE(coro::sync_wait(produce_one(rb, v)));
+
+    // Only 3 slots are free: the batch claims them, then waits for consumers to free the rest.
+    std::vector<std::uint64_t> items;
+    for (std::uint64_t v = 0; v < 20; ++v) items.push_back(v);
+    std::size_t produced = 0;
+    std::thread producer_thread{[&] { produced = coro::sync_wait(produce_all(rb, items)); }};
+
+    std::vector<std::uint64_t> received;
+    std::vector<std::uint64_t> out(6);
+    while (received.size() < 25) {
+        const std::size_t n = coro::sync_wait(consume_some(rb, out));
+        REQUIRE(n > 0);
+        REQUIRE(n <= out.size());
+        received.insert(received.end(), out.begin(), out.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    producer_thread.join();
+    REQUIRE(produced == 20);
+    for (std::size_t i = 0; i < 5; ++i) REQUIRE(received[i] == 100 + i);
+    for (std::size_t i = 5; i < 25; ++i) REQUIRE(received[i] == i - 5);
+
+    // A batch larger than what is buffered takes what is there without waiting.
+    for (std::uint64_t v = 0; v < 3; ++v) REQUIRE(coro::sync_wait(produce_one(rb, v)));
+    std::vector<std::uint64_t> big(8);
+    REQUIRE(coro::sync_wait(consume_some(rb, big)) == 3);
+    REQUIRE(rb.empty());
+}
+
+TEST_CASE("mpmc_ring_buffer delivers every element once with many producers and consumers",
+          "[coro_ext][mpmc_ring_buffer]") {
+    constexpr std::uint64_t kProducers = 4;
+    constexpr std::uint64_t kConsumers = 4;
+    constexpr std::uint64_t kPerProducer = 20'000;
+    coro_ext::mpmc_ring_buffer<std::uint64_t, 64> rb;
+
+    std::atomic<std::uint64_t> producers_left{kProducers};
+    std::vector<std::thread> threads;
+    std::vector<consumed> results(kConsumers);
+    std::vector<std::uint64_t> accepted(kProducers, 0);
+    for (std::uint64_t c = 0; c < kConsumers; ++c)
+        threads.emplace_back([&, c] { results[c] = coro::sync_wait(consumer(rb)); });
+    for (std::uint64_t p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            accepted[p] = coro::sync_wait(producer(rb, p * kPerProducer, (p + 1) * kPerProducer));
+            if (producers_left.fetch_sub(1) == 1) rb.shutdown();
+        });
+    }
+    for (auto &t : threads) t.join();
+    for (const auto a : accepted) REQUIRE(a == kPerProducer);
+
+    constexpr std::uint64_t kTotal = kProducers * kPerProducer;
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::vector<std::uint8_t> seen(kTotal, 0);
+    std::uint64_t duplicates = 0;
+    for (const auto &r : results) {
+        count += r.count;
+        sum += r.sum;
+        for (const auto v : r.values) duplicates += seen[v]++ != 0 ? 1 : 0;
+    }
+    REQUIRE(duplicates == 0);
+    REQUIRE(count == kTotal);
+    REQUIRE(sum == kTotal * (kTotal - 1) / 2);
+}
+
+TEST_CASE("mpmc_ring_buffer shutdown fails producers and lets consumers drain", "[coro_ext][mpmc_ring_buffer]") {
+    SECTION("waiting consumer and producer are released") {
+        coro_ext::mpmc_ring_buffer<std::uint64_t, 2> empty_rb;
+        std::optional<std::uint64_t> consumed_value{42};
+        std::thread waiting_consumer{[&] { consumed_value = coro::sync_wait(consume_one(empty_rb)); }};
+
+        coro_ext::mpmc_ring_buffer<std::uint64_t, 2> full_rb;
+        REQUIRE(coro::sync_wait(produce_one(full_rb, 1)));
+        REQUIRE(coro::sync_wait(produce_one(full_rb, 2)));
+        bool produced = true;
+        std::thread waiting_producer{[&] { produced = coro::sync_wait(produce_one(full_rb, 3)); }};
+
+        std::this_thread::sleep_for(20ms);
+        empty_rb.shutdown();
+        full_rb.shutdown();
+        waiting_consumer.join();
+        waiting_producer.join();
+        REQUIRE_FALSE(consumed_value.has_value());
+        REQUIRE_FALSE(produced);
+
+        // What was buffered before the stop is still delivered, then the stop shows.
+        REQUIRE(coro::sync_wait(consume_one(full_rb)) == 1);
+        REQUIRE(coro::sync_wait(consume_one(full_rb)) == 2);
+        REQUIRE_FALSE(coro::sync_wait(consume_one(full_rb)).has_value());
+        std::vector<std::uint64_t> out(4);
+        REQUIRE(coro::sync_wait(consume_some(full_rb, out)) == 0);
+    }
+
+    SECTION("operations after shutdown") {
+        coro_ext::mpmc_ring_buffer<std::uint64_t, 4> rb;
+        rb.shutdown();
+        rb.shutdown();
+        REQUIRE_FALSE(coro::sync_wait(produce_one(rb, 1)));
+        std::uint64_t v = 1;
+        REQUIRE_FALSE(rb.try_produce(v));
+        std::vector<std::uint64_t> items{1, 2};
+        REQUIRE(coro::sync_wait(produce_all(rb, items)) == 0);
+        REQUIRE_FALSE(coro::sync_wait(consume_one(rb)).has_value());
+        REQUIRE(rb.empty());
+    }
+}
+
+TEST_CASE("mpmc_ring_buffer delivers every accepted element when shutdown races producers",
+          "[coro_ext][mpmc_ring_buffer]") {
+    for (int round = 0; round < 50; ++round) {
+        coro_ext::mpmc_ring_buffer<std::uint64_t, 16> rb;
+        std::vector<std::uint64_t> accepted(3, 0);
+        std::vector<consumed> results(2);
+        std::vector<std::thread> threads;
+        for (std::size_t c = 0; c < results.size(); ++c)
+            threads.emplace_back([&, c] { results[c] = coro::sync_wait(consumer(rb)); });
+        for (std::size_t p = 0; p < accepted.size(); ++p) {
+            threads.emplace_back([&, p] {
+                // Unbounded: only the shutdown ends these producers.
+                accepted[p] = coro::sync_wait(producer(rb, p << 40, (p + 1) << 40));
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100 * (round % 10)));
+        rb.shutdown();
+        for (auto &t : threads) t.join();
+
+        std::uint64_t total_accepted = 0;
+        std::uint64_t total_consumed = 0;
+        for (const auto a : accepted) total_accepted += a;
+        for (const auto &r : results) total_consumed += r.count;
+        REQUIRE(total_consumed == total_accepted);
+        REQUIRE(rb.empty());
+    }
+}
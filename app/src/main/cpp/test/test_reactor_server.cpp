@@ -0,0 +1,157 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/reactor_server.hpp"
+#include "coro_ext/vectored_io.hpp"
+
+#include <coro/coro.hpp>
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+coro::task<void> echo_connection(std::shared_ptr<coro::io_scheduler> scheduler, int fd) {
+    co_await scheduler->schedule();
+    std::array<char, 4096> buffer;
+    for (;;) {
+        const ssize_t n = ::read(fd, buffer.data(), buffer.size());
+        if (n == 0) co_return;
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) co_return;
+            if (co_await scheduler->poll(fd, coro::poll_op::read) != coro::poll_status::event) co_return;
+            continue;
+        }
+        const std::span<const char> part{buffer.data(), static_cast<std::size_t>(n)};
+        if (co_await coro_ext::write_all(scheduler, fd, std::span{&part, 1}) < 0) co_return;
+    }
+}
+
+// Blocking loopback client; -1 when the connection is refused.
+int connect_to(std::uint16_t port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool echoes(int fd, const std::string &message) {
+    if (::send(fd, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(message.size())) return false;
+    std::string reply(message.size(), '\0');
+    for (std::size_t got = 0; got < reply.size();) {
+        const ssize_t n = ::recv(fd, reply.data() + got, reply.size() - got, 0);
+        if (n <= 0) return false;
+        got += static_cast<std::size_t>(n);
+    }
+    return reply == message;
+}
+
+// Listening TCP sockets of this process bound to `port`, found through /proc/self/fd.
+std::size_t listeners_on(std::uint16_t port) {
+    std::size_t count = 0;
+    DIR *dir = ::opendir("/proc/self/fd");
+    if (!dir) return 0;
+    while (const dirent *entry = ::readdir(dir)) {
+        const int fd = std::atoi(entry->d_name);
+        if (fd <= 0 && entry->d_name[0] != '0') continue;
+        int listening = 0;
+        socklen_t size = sizeof(listening);
+        if (::getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &size) != 0 || !listening) continue;
+        sockaddr_storage addr{};
+        socklen_t addr_size = sizeof(addr);
+        if (::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &addr_size) != 0) continue;
+        if (addr.ss_family == AF_INET && ntohs(reinterpret_cast<sockaddr_in *>(&addr)->sin_port) == port) ++count;
+    }
+    ::closedir(dir);
+    return count;
+}
+
+// Runs server.run() on its own thread; the future is ready once run() has returned.
+std::future<void> start(coro_ext::reactor_server &server) {
+    return std::async(std::launch::async, [&server] { coro::sync_wait(server.run()); });
+}
+
+} // namespace
+
+TEST_CASE("reactor_server spreads connections over its listeners and echoes on each", "[coro_ext][reactor_server]") {
+    constexpr std::uint32_t kReactors = 4;
+    constexpr int kConnections = 200;
+    coro_ext::reactor_server server{coro_ext::reactor_server::options{.reactor_count = kReactors}, echo_connection};
+    REQUIRE(server.reactor_count() == kReactors);
+    REQUIRE(server.port() != 0);
+    // Every listener joined the first one's ephemeral port.
+    CHECK(listeners_on(server.port()) == kReactors);
+    auto running = start(server);
+
+    // All connections stay open at once, so each reactor serves many concurrently.
+    std::vector<int> clients;
+    for (int i = 0; i < kConnections; ++i) clients.push_back(connect_to(server.port()));
+    int echoed = 0;
+    for (int i = 0; i < kConnections; ++i) {
+        if (clients[i] >= 0 && echoes(clients[i], "connection " + std::to_string(i) + std::string(i, 'x'))) ++echoed;
+    }
+    for (const int fd : clients) ::close(fd);
+    CHECK(echoed == kConnections);
+
+    // The kernel hashes connections over the listeners; with 200 of them every reactor gets some.
+    std::uint64_t accepted = 0;
+    for (std::size_t r = 0; r < kReactors; ++r) {
+        CHECK(server.accepted(r) > 0);
+        accepted += server.accepted(r);
+    }
+    CHECK(accepted == kConnections);
+
+    server.shutdown();
+    REQUIRE(running.wait_for(10s) == std::future_status::ready);
+}
+
+TEST_CASE("reactor_server shutdown stops accepting and closes open connections", "[coro_ext][reactor_server]") {
+    coro_ext::reactor_server server{coro_ext::reactor_server::options{.reactor_count = 2}, echo_connection};
+    auto running = start(server);
+
+    // Idle clients that never disconnect on their own.
+    std::vector<int> clients;
+    for (int i = 0; i < 8; ++i) {
+        clients.push_back(connect_to(server.port()));
+        REQUIRE(clients.back() >= 0);
+        REQUIRE(echoes(clients.back(), "ping"));
+    }
+
+    server.shutdown();
+    server.shutdown();
+    // run() returns even though no client has closed its end.
+    REQUIRE(running.wait_for(10s) == std::future_status::ready);
+
+    for (const int fd : clients) {
+        char byte = 0;
+        CHECK(::recv(fd, &byte, 1, 0) <= 0);
+        ::close(fd);
+    }
+    const int late = connect_to(server.port());
+    CHECK(late < 0);
+    if (late >= 0) ::close(late);
+}
@@ -0,0 +1,62 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/record_buffer_pool.hpp"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("record_buffer_pool reuses released buffers", "[coro_ext][record_buffer_pool]") {
+    coro_ext::record_buffer_pool pool;
+    REQUIRE(pool.buffer_size() == coro_ext::record_buffer_pool::max_record_size);
+
+    char *first = nullptr;
+    {
+        auto lease = pool.acquire();
+        REQUIRE(lease);
+        CHECK(lease.size() == pool.buffer_size());
+        CHECK(lease.span().size() == lease.size());
+        first = lease.data();
+        CHECK(pool.cached() == 0);
+    }
+    CHECK(pool.cached() == 1);
+    auto again = pool.acquire();
+    CHECK(again.data() == first);
+    CHECK(pool.cached() == 0);
+}
+
+TEST_CASE("record_buffer_pool moves leases and caps idle buffers", "[coro_ext][record_buffer_pool]") {
+    coro_ext::record_buffer_pool pool{coro_ext::record_buffer_pool::options{.buffer_size = 256, .max_cached = 2}};
+    std::vector<coro_ext::record_buffer_pool::buffer> leases;
+    for (int i = 0; i < 4; ++i) leases.push_back(pool.acquire());
+
+    // A moved-from lease is empty and returns nothing to the pool.
+    auto moved = std::move(leases[0]);
+    CHECK_FALSE(leases[0]);
+    CHECK(moved.size() == 256);
+    leases[0] = std::move(moved);
+    CHECK(pool.cached() == 0);
+
+    leases.clear();
+    CHECK(pool.cached() == 2);
+}
+
+TEST_CASE("record_buffer_pool is shared across threads", "[coro_ext][record_buffer_pool]") {
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 1000;
+    coro_ext::record_buffer_pool pool{coro_ext::record_buffer_pool::options{.buffer_size = 64, .max_cached = 8}};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&pool, t] {
+            for (int i = 0; i < kRounds; ++i) {
+                auto lease = pool.acquire();
+                lease.data()[0] = static_cast<char>(t);
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+    CHECK(pool.cached() >= 1);
+    CHECK(pool.cached() <= kThreads);
+}
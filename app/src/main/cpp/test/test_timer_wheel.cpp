@@ -0,0 +1,262 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/timer_wheel.hpp"
+
+#include <coro/coro.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+using clock_type = std::chrono::steady_clock;
+using coro_ext::timer_wheel;
+
+// Generous upper bound on lateness: the tests only check that timers fire in the right place, not how precisely.
+constexpr auto kSlack = 200ms;
+
+std::shared_ptr<coro::io_scheduler> make_inline_scheduler() {
+    return coro::io_scheduler::make_shared(coro::io_scheduler::options{
+        .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+}
+
+struct firing {
+    clock_type::time_point armed;
+    std::chrono::nanoseconds timeout;
+    clock_type::time_point fired{};
+    int count = 0;
+};
+
+// Runs `driver` next to wheel.run() on `scheduler`. The driver (or a callback) must shut the wheel down, so run()
+// returns.
+void run_with_wheel(std::shared_ptr<coro::io_scheduler> scheduler, timer_wheel &wheel, coro::task<void> driver) {
+    std::vector<coro::task<void>> tasks;
+    tasks.emplace_back(wheel.run(std::move(scheduler)));
+    tasks.emplace_back(std::move(driver));
+    coro::sync_wait(coro::when_all(std::move(tasks)));
+}
+
+coro::task<void> arm_each(std::shared_ptr<coro::io_scheduler> scheduler, timer_wheel &wheel,
+                          std::vector<std::unique_ptr<timer_wheel::timer>> &timers,
+                          const std::vector<std::chrono::nanoseconds> &timeouts, std::vector<firing> &firings) {
+    co_await scheduler->schedule();
+    for (std::size_t i = 0; i < timeouts.size(); ++i) {
+        firings[i].armed = clock_type::now();
+        firings[i].timeout = timeouts[i];
+        wheel.arm(*timers[i], timeouts[i]);
+    }
+    co_return;
+}
+
+coro::task<void> arm_callback_timers(std::shared_ptr<coro::io_scheduler> scheduler, timer_wheel &wheel,
+                                     timer_wheel::timer &victim, timer_wheel::timer &self_cancel,
+                                     timer_wheel::timer &repeating) {
+    co_await scheduler->schedule();
+    wheel.arm(victim, 30ms);
+    wheel.arm(self_cancel, 500us);
+    wheel.arm(repeating, 1ms);
+    co_return;
+}
+
+coro::task<void> sleep_on_wheel(std::shared_ptr<coro::io_scheduler> scheduler, timer_wheel &wheel,
+                                std::chrono::nanoseconds duration, bool &resumed) {
+    co_await scheduler->schedule();
+    co_await wheel.sleep_for(duration);
+    resumed = true;
+    co_return;
+}
+
+struct shutdown_observations {
+    std::size_t armed_before_shutdown = 0;
+    bool sleep_after_shutdown_returned = false;
+};
+
+coro::task<void> arm_then_shut_down(std::shared_ptr<coro::io_scheduler> scheduler, timer_wheel &wheel,
+                                    timer_wheel::timer &hour, timer_wheel::timer &day, timer_wheel::timer &after,
+                                    shutdown_observations &seen) {
+    co_await scheduler->schedule();
+    wheel.arm(hour, 1h);
+    wheel.arm(day, 24h);
+    // Gives the sleeper time to suspend on the wheel.
+    co_await scheduler->yield_for(10ms);
+    seen.armed_before_shutdown = wheel.size();
+    wheel.shutdown();
+    // After shutdown() nothing is armed and nothing suspends.
+    wheel.arm(after, 1ms);
+    co_await wheel.sleep_for(1h);
+    seen.sleep_after_shutdown_returned = true;
+    co_return;
+}
+
+struct idle_timers {
+    timer_wheel::timer cancelled;
+    timer_wheel::timer pending;
+    timer_wheel::timer first;
+    timer_wheel::timer second;
+    firing empty_wheel;
+    firing behind_pending;
+};
+
+coro::task<void> arm_after_idle(std::shared_ptr<coro::io_scheduler> scheduler, timer_wheel &wheel, idle_timers &t) {
+    co_await scheduler->schedule();
+    // The timerfd stays programmed for the cancelled timer: run() wakes once and finds nothing due.
+    wheel.arm(t.cancelled, 1ms);
+    t.cancelled.cancel();
+    co_await scheduler->yield_for(300ms);
+
+    t.empty_wheel.armed = clock_type::now();
+    t.empty_wheel.timeout = 5ms;
+    wheel.arm(t.first, 5ms);
+    co_await scheduler->yield_for(50ms);
+
+    // A far-off timer keeps the wheel non-empty, so run() does not wake up while idle.
+    wheel.arm(t.pending, 10s);
+    co_await scheduler->yield_for(300ms);
+    t.behind_pending.armed = clock_type::now();
+    t.behind_pending.timeout = 5ms;
+    wheel.arm(t.second, 5ms);
+    co_await scheduler->yield_for(50ms);
+
+    t.pending.cancel();
+    wheel.shutdown();
+    co_return;
+}
+
+} // namespace
+
+TEST_CASE("timer_wheel fires timers across level boundaries in deadline order", "[coro_ext][timer_wheel]") {
+    // With a 1 us tick, level 0 covers 256 us and level 1 65 ms: these timeouts sit in levels 0, 1 and 2 and are
+    // cascaded down (some through two levels) before they fire.
+    const std::vector<std::chrono::nanoseconds> timeouts{120ms, 50us, 3ms, 70ms, 300us, 20ms, 255us, 66ms};
+    timer_wheel wheel{timer_wheel::options{.tick = 1us}};
+    std::vector<firing> firings(timeouts.size());
+    std::vector<std::size_t> order;
+    std::vector<std::unique_ptr<timer_wheel::timer>> timers;
+    for (std::size_t i = 0; i < timeouts.size(); ++i) {
+        timers.push_back(std::make_unique<timer_wheel::timer>([&, i] {
+            firings[i].fired = clock_type::now();
+            ++firings[i].count;
+            order.push_back(i);
+            if (order.size() == timeouts.size()) wheel.shutdown();
+        }));
+    }
+
+    auto scheduler = make_inline_scheduler();
+    run_with_wheel(scheduler, wheel, arm_each(scheduler, wheel, timers, timeouts, firings));
+
+    REQUIRE(order.size() == timeouts.size());
+    REQUIRE(wheel.size() == 0);
+    for (std::size_t n = 1; n < order.size(); ++n) CHECK(timeouts[order[n - 1]] <= timeouts[order[n]]);
+    for (const auto &f : firings) {
+        CHECK(f.count == 1);
+        CHECK(f.fired >= f.armed + f.timeout);
+        CHECK(f.fired < f.armed + f.timeout + kSlack);
+    }
+}
+
+TEST_CASE("timer_wheel callbacks may re-arm and cancel timers", "[coro_ext][timer_wheel]") {
+    timer_wheel wheel{timer_wheel::options{.tick = 100us}};
+    int ticks = 0;
+    int victim_fired = 0;
+    int late_fired = 0;
+    int self_cancel_fired = 0;
+    timer_wheel::timer victim{[&] { ++victim_fired; }};
+    timer_wheel::timer late;
+    timer_wheel::timer self_cancel;
+    timer_wheel::timer repeating;
+    const auto maybe_done = [&] {
+        if (ticks == 5 && late_fired == 1) wheel.shutdown();
+    };
+    late.set_callback([&] {
+        ++late_fired;
+        maybe_done();
+    });
+    self_cancel.set_callback([&] {
+        ++self_cancel_fired;
+        // Re-armed, then cancelled again within its own callback: it must not fire a second time.
+        wheel.arm(self_cancel, 1ms);
+        self_cancel.cancel();
+    });
+    repeating.set_callback([&] {
+        ++ticks;
+        if (ticks == 2) {
+            // Cancel a timer due later and arm one that fires before the victim would have.
+            victim.cancel();
+            wheel.arm(late, 2ms);
+        }
+        if (ticks < 5) wheel.arm(repeating, 1ms);
+        maybe_done();
+    });
+
+    auto scheduler = make_inline_scheduler();
+    run_with_wheel(scheduler, wheel, arm_callback_timers(scheduler, wheel, victim, self_cancel, repeating));
+
+    CHECK(ticks == 5);
+    CHECK(late_fired == 1);
+    CHECK(victim_fired == 0);
+    CHECK(self_cancel_fired == 1);
+    CHECK_FALSE(victim.armed());
+    CHECK_FALSE(self_cancel.armed());
+    CHECK_FALSE(repeating.armed());
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("timer_wheel shutdown fires pending timers and releases sleepers", "[coro_ext][timer_wheel]") {
+    timer_wheel wheel;
+    int hour_fired = 0;
+    int day_fired = 0;
+    int after_fired = 0;
+    bool sleeper_resumed = false;
+    shutdown_observations seen;
+    timer_wheel::timer hour{[&] { ++hour_fired; }};
+    timer_wheel::timer day{[&] { ++day_fired; }};
+    timer_wheel::timer after{[&] { ++after_fired; }};
+    const auto started = clock_type::now();
+
+    auto scheduler = make_inline_scheduler();
+    std::vector<coro::task<void>> tasks;
+    tasks.emplace_back(wheel.run(scheduler));
+    tasks.emplace_back(sleep_on_wheel(scheduler, wheel, 1h, sleeper_resumed));
+    tasks.emplace_back(arm_then_shut_down(scheduler, wheel, hour, day, after, seen));
+    coro::sync_wait(coro::when_all(std::move(tasks)));
+
+    CHECK(seen.armed_before_shutdown == 3);
+    CHECK(hour_fired == 1);
+    CHECK(day_fired == 1);
+    CHECK(sleeper_resumed);
+    CHECK(seen.sleep_after_shutdown_returned);
+    CHECK(after_fired == 0);
+    CHECK_FALSE(after.armed());
+    CHECK(wheel.size() == 0);
+    CHECK(clock_type::now() - started < 10s);
+}
+
+TEST_CASE("timer_wheel places timers armed after an idle period", "[coro_ext][timer_wheel]") {
+    // 300 ms idle at a 100 us tick is 3000 ticks, past the 256 ticks of level 0. A timer armed afterwards must still
+    // fire after its own timeout, measured from when it is armed, not from the last tick run() processed.
+    timer_wheel wheel{timer_wheel::options{.tick = 100us}};
+    idle_timers t;
+    t.first.set_callback([&t] {
+        t.empty_wheel.fired = clock_type::now();
+        ++t.empty_wheel.count;
+    });
+    t.second.set_callback([&t] {
+        t.behind_pending.fired = clock_type::now();
+        ++t.behind_pending.count;
+    });
+
+    auto scheduler = make_inline_scheduler();
+    run_with_wheel(scheduler, wheel, arm_after_idle(scheduler, wheel, t));
+
+    for (const auto *f : {&t.empty_wheel, &t.behind_pending}) {
+        CHECK(f->count == 1);
+        CHECK(f->fired >= f->armed + f->timeout);
+        CHECK(f->fired < f->armed + f->timeout + kSlack);
+    }
+}
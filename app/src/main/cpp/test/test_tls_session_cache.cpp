@@ -0,0 +1,243 @@
+// All code comments are in English per repo policy.
+
+#ifdef LIBCORO_FEATURE_TLS
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/record_buffer_pool.hpp"
+#include "coro_ext/tls_session_cache.hpp"
+#include "test/tls_loopback.hpp"
+
+#include <coro/coro.hpp>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+struct handshake_result {
+    bool ok = false;
+    bool resumed = false;
+};
+
+// One connection; prepare(ssl, peer) is called first unless peer is empty.
+handshake_result connect_once(SSL_CTX *client_ctx, SSL_CTX *server_ctx, coro_ext::tls_session_cache &cache,
+                              const std::string &peer = {}) {
+    tls_loopback::connection conn{client_ctx, server_ctx};
+    if (!conn) return {};
+    if (!peer.empty()) cache.prepare(conn.client.get(), peer);
+    handshake_result result;
+    result.ok = conn.handshake();
+    if (result.ok) {
+        result.resumed = conn.resumed();
+        conn.read_tickets();
+        conn.close();
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("tls_session_cache resumes through attach() alone", "[coro_ext][tls_session_cache]") {
+    auto server_ctx = tls_loopback::make_server_ctx();
+    auto client_ctx = tls_loopback::make_client_ctx();
+    REQUIRE(server_ctx);
+    REQUIRE(client_ctx);
+    coro_ext::tls_session_cache cache;
+    cache.attach(client_ctx.get());
+
+    const auto first = connect_once(client_ctx.get(), server_ctx.get(), cache);
+    REQUIRE(first.ok);
+    REQUIRE_FALSE(first.resumed);
+    // No socket behind the BIO pair: the key is the SNI host alone.
+    REQUIRE(cache.size() == 1);
+
+    const auto second = connect_once(client_ctx.get(), server_ctx.get(), cache);
+    REQUIRE(second.ok);
+    REQUIRE(second.resumed);
+    REQUIRE(cache.statistics().hits == 1);
+}
+
+TEST_CASE("tls_session_cache hands out each TLS 1.3 ticket once", "[coro_ext][tls_session_cache]") {
+    auto server_ctx = tls_loopback::make_server_ctx();
+    auto client_ctx = tls_loopback::make_client_ctx();
+    REQUIRE(server_ctx);
+    REQUIRE(client_ctx);
+    SSL_CTX_set_num_tickets(server_ctx.get(), 2);
+    coro_ext::tls_session_cache cache;
+    cache.attach(client_ctx.get());
+
+    REQUIRE(connect_once(client_ctx.get(), server_ctx.get(), cache, "peer").ok);
+    REQUIRE(cache.statistics().stored == 2);
+
+    // Two connections opened before either receives new tickets consume the two cached tickets; a third finds none.
+    tls_loopback::connection a{client_ctx.get(), server_ctx.get()};
+    tls_loopback::connection b{client_ctx.get(), server_ctx.get()};
+    tls_loopback::connection c{client_ctx.get(), server_ctx.get()};
+    REQUIRE(cache.prepare(a.client.get(), "peer"));
+    REQUIRE(cache.prepare(b.client.get(), "peer"));
+    REQUIRE(cache.size() == 0);
+    REQUIRE_FALSE(cache.prepare(c.client.get(), "peer"));
+    REQUIRE(SSL_get_session(a.client.get()) != SSL_get_session(b.client.get()));
+
+    REQUIRE(a.handshake());
+    REQUIRE(b.handshake());
+    REQUIRE(c.handshake());
+    REQUIRE(a.resumed());
+    REQUIRE(b.resumed());
+    REQUIRE_FALSE(c.resumed());
+}
+
+TEST_CASE("tls_session_cache keeps offering a TLS 1.2 session", "[coro_ext][tls_session_cache]") {
+    auto server_ctx = tls_loopback::make_server_ctx(TLS1_2_VERSION);
+    auto client_ctx = tls_loopback::make_client_ctx();
+    REQUIRE(server_ctx);
+    REQUIRE(client_ctx);
+    coro_ext::tls_session_cache cache;
+    cache.attach(client_ctx.get());
+
+    REQUIRE(connect_once(client_ctx.get(), server_ctx.get(), cache, "peer").ok);
+    for (int i = 0; i < 3; ++i) {
+        const auto r = connect_once(client_ctx.get(), server_ctx.get(), cache, "peer");
+        REQUIRE(r.ok);
+        REQUIRE(r.resumed);
+        REQUIRE(cache.size() == 1);
+    }
+}
+
+TEST_CASE("tls_session_cache evicts the least recently used peer", "[coro_ext][tls_session_cache]") {
+    auto server_ctx = tls_loopback::make_server_ctx();
+    auto client_ctx = tls_loopback::make_client_ctx();
+    REQUIRE(server_ctx);
+    REQUIRE(client_ctx);
+    coro_ext::tls_session_cache cache{coro_ext::tls_session_cache::options{.capacity = 2}};
+    cache.attach(client_ctx.get());
+
+    REQUIRE(connect_once(client_ctx.get(), server_ctx.get(), cache, "a").ok);
+    REQUIRE(connect_once(client_ctx.get(), server_ctx.get(), cache, "b").ok);
+    // Resuming "a" stores its new tickets and makes it the most recent, so "c" evicts "b".
+    REQUIRE(connect_once(client_ctx.get(), server_ctx.get(), cache, "a").resumed);
+    REQUIRE(connect_once(client_ctx.get(), server_ctx.get(), cache, "c").ok);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(connect_once(client_ctx.get(), server_ctx.get(), cache, "a").resumed);
+    REQUIRE_FALSE(connect_once(client_ctx.get(), server_ctx.get(), cache, "b").resumed);
+
+    cache.remove("a");
+    REQUIRE_FALSE(connect_once(client_ctx.get(), server_ctx.get(), cache, "a").resumed);
+}
+
+TEST_CASE("tls_session_cache keys untagged connections by socket peer", "[coro_ext][tls_session_cache]") {
+    auto server_ctx = tls_loopback::make_server_ctx();
+    auto client_ctx = tls_loopback::make_client_ctx();
+    REQUIRE(server_ctx);
+    REQUIRE(client_ctx);
+    coro_ext::tls_session_cache cache;
+    cache.attach(client_ctx.get());
+
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(listener >= 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    REQUIRE(::bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    REQUIRE(::listen(listener, 4) == 0);
+    REQUIRE(::getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &addr_len) == 0);
+
+    // No SNI: the key is the server's "ip:port".
+    const auto connect_tcp = [&] {
+        const int client_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        REQUIRE(::connect(client_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+        const int server_fd = ::accept(listener, nullptr, nullptr);
+        REQUIRE(server_fd >= 0);
+        ::fcntl(client_fd, F_SETFL, O_NONBLOCK);
+        ::fcntl(server_fd, F_SETFL, O_NONBLOCK);
+        tls_loopback::ssl_ptr client{SSL_new(client_ctx.get())};
+        tls_loopback::ssl_ptr server{SSL_new(server_ctx.get())};
+        SSL_set_fd(client.get(), client_fd);
+        SSL_set_fd(server.get(), server_fd);
+        SSL_set_connect_state(client.get());
+        SSL_set_accept_state(server.get());
+        while (!SSL_is_init_finished(client.get()) || !SSL_is_init_finished(server.get())) {
+            SSL_do_handshake(client.get());
+            SSL_do_handshake(server.get());
+        }
+        char byte = 0;
+        for (int i = 0; i < 4; ++i) SSL_read(client.get(), &byte, 1); // NewSessionTicket messages
+        const bool resumed = SSL_session_reused(client.get()) == 1;
+        // Without a clean shutdown OpenSSL marks the session not resumable when the SSL is freed.
+        SSL_shutdown(client.get());
+        ::close(client_fd);
+        ::close(server_fd);
+        return resumed;
+    };
+
+    REQUIRE_FALSE(connect_tcp());
+    REQUIRE(cache.size() == 1);
+    REQUIRE(connect_tcp());
+
+    tls_loopback::connection probe{client_ctx.get(), server_ctx.get()};
+    REQUIRE(cache.prepare(probe.client.get(), "127.0.0.1:" + std::to_string(ntohs(addr.sin_port))));
+    ::close(listener);
+}
+
+TEST_CASE("tls_session_cache resumes net::tls::client connections", "[coro_ext][tls_session_cache]") {
+    // Not the port test_tls_server.cpp or bench_tls_session_cache.cpp listen on.
+    constexpr std::uint16_t kPort = 8444;
+    const auto dir = std::filesystem::temp_directory_path() / ("tls_session_cache_test_" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    const std::string cert = (dir / "cert.pem").string();
+    const std::string key = (dir / "key.pem").string();
+    REQUIRE(tls_loopback::self_signed{}.write_pem(cert, key));
+    // No client certificates: a server that requests them also needs a session id context to resume sessions.
+    auto server_ctx = std::make_shared<coro::net::tls::context>(cert, coro::net::tls::tls_file_type::pem, key,
+                                                                coro::net::tls::tls_file_type::pem,
+                                                                coro::net::tls::verify_peer_t::no);
+    std::filesystem::remove_all(dir);
+    auto client_ctx = std::make_shared<coro::net::tls::context>(coro::net::tls::verify_peer_t::no);
+
+    coro_ext::record_buffer_pool buffers{coro_ext::record_buffer_pool::options{.max_cached = 2}};
+    coro_ext::tls_session_cache cache;
+    // The only cache-specific step: the clients below are plain net::tls::client objects.
+    cache.attach(*client_ctx);
+    REQUIRE(coro_ext::native_handle(*client_ctx) != nullptr);
+
+    auto server_scheduler = coro::io_scheduler::make_shared(coro::io_scheduler::options{
+        .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+    auto client_scheduler = coro::io_scheduler::make_shared(coro::io_scheduler::options{
+        .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+    coro::net::tls::server server{server_scheduler, server_ctx, coro::net::tls::server::options{.port = kPort}};
+    std::atomic<bool> stop{false};
+    std::thread server_thread{
+        [&] { coro::sync_wait(tls_loopback::net_serve(server_scheduler, server, buffers, stop)); }};
+
+    std::int64_t received[3] = {};
+    for (auto &r : received) {
+        r = coro::sync_wait(tls_loopback::net_request(client_scheduler, client_ctx, kPort, 100, buffers));
+    }
+    const auto stats = cache.statistics();
+    const long resumed = SSL_CTX_sess_hits(coro_ext::native_handle(*server_ctx));
+    const std::size_t peers = cache.size();
+    tls_loopback::net_stop(stop, kPort);
+    server_thread.join();
+
+    for (const auto r : received) CHECK(r == 100);
+    // The first connection does a full handshake; the server resumed the other two.
+    CHECK(stats.misses == 1);
+    CHECK(stats.hits == 2);
+    CHECK(resumed == 2);
+    CHECK(peers == 1);
+    // Every connection returned its buffers; at most max_cached stay pooled.
+    CHECK(buffers.cached() == 2);
+}
+
+#endif // LIBCORO_FEATURE_TLS
@@ -0,0 +1,275 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/udp_batch.hpp"
+
+#include <coro/coro.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+std::shared_ptr<coro::io_scheduler> make_inline_scheduler() {
+    return coro::io_scheduler::make_shared(coro::io_scheduler::options{
+        .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+}
+
+int open_bound() {
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) return -1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    const int buffer = 1 << 20;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+sockaddr_in local_address(int fd) {
+    sockaddr_in addr{};
+    socklen_t size = sizeof(addr);
+    ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &size);
+    return addr;
+}
+
+// Two bound loopback UDP sockets; the sender is connected to the receiver, the receiver is left unconnected so it
+// reports the source address of every datagram.
+struct udp_pair {
+    int sender = -1;
+    int receiver = -1;
+
+    udp_pair() : sender(open_bound()), receiver(open_bound()) {
+        REQUIRE(sender >= 0);
+        REQUIRE(receiver >= 0);
+        const sockaddr_in to = local_address(receiver);
+        REQUIRE(::connect(sender, reinterpret_cast<const sockaddr *>(&to), sizeof(to)) == 0);
+    }
+    udp_pair(const udp_pair &) = delete;
+    udp_pair &operator=(const udp_pair &) = delete;
+    ~udp_pair() {
+        if (sender >= 0) ::close(sender);
+        if (receiver >= 0) ::close(receiver);
+    }
+};
+
+// Waits until `fd` is readable; loopback delivery is synchronous, so this only guards against a lost datagram.
+bool readable(int fd) {
+    pollfd p{fd, POLLIN, 0};
+    return ::poll(&p, 1, 1000) == 1;
+}
+
+// Datagrams whose data points into `payloads`.
+std::vector<coro_ext::udp_batch::datagram> datagrams_of(std::vector<std::string> &payloads) {
+    std::vector<coro_ext::udp_batch::datagram> out(payloads.size());
+    for (std::size_t i = 0; i < payloads.size(); ++i) out[i].data = std::span<char>{payloads[i]};
+    return out;
+}
+
+// Sends every datagram of `out`, waiting for the socket to drain when the kernel takes only part of a batch.
+coro::task<void> send_all(std::shared_ptr<coro::io_scheduler> scheduler, coro_ext::udp_batch &batch, int fd,
+                          std::span<const coro_ext::udp_batch::datagram> out, std::vector<int> &sent_per_call) {
+    co_await scheduler->schedule();
+    while (!out.empty()) {
+        const int sent = batch.send(fd, out);
+        sent_per_call.push_back(sent);
+        if (sent < 0) co_return;
+        if (sent == 0) {
+            if (co_await scheduler->poll(fd, coro::poll_op::write, 5s) != coro::poll_status::event) co_return;
+            continue;
+        }
+        out = out.subspan(static_cast<std::size_t>(sent));
+    }
+    co_return;
+}
+
+// Receives `expected` datagrams through one poll() + recv() per burst and stores their payloads and sources.
+coro::task<void> receive_all(std::shared_ptr<coro::io_scheduler> scheduler, coro_ext::udp_batch &batch, int fd,
+                             std::size_t expected, std::vector<std::string> &payloads,
+                             std::vector<sockaddr_in> &sources) {
+    co_await scheduler->schedule();
+    std::vector<std::string> buffers(batch.max_batch(), std::string(2048, '\0'));
+    std::vector<coro_ext::udp_batch::datagram> slots = datagrams_of(buffers);
+    while (payloads.size() < expected) {
+        const int received = batch.recv(fd, slots);
+        if (received < 0) co_return;
+        if (received == 0) {
+            if (co_await scheduler->poll(fd, coro::poll_op::read, 5s) != coro::poll_status::event) co_return;
+            continue;
+        }
+        for (int i = 0; i < received; ++i) {
+            payloads.emplace_back(slots[i].data.data(), slots[i].size);
+            sockaddr_in source{};
+            std::memcpy(&source, &slots[i].address, sizeof(source));
+            sources.push_back(source);
+        }
+    }
+    co_return;
+}
+
+} // namespace
+
+TEST_CASE("udp_batch moves many datagrams per recvmmsg and sendmmsg", "[coro_ext][udp_batch]") {
+    constexpr std::size_t kDatagrams = 150;
+    udp_pair sockets;
+    std::vector<std::string> sent_payloads;
+    for (std::size_t i = 0; i < kDatagrams; ++i) {
+        const std::string filler(i * 7 % 1200, static_cast<char>('a' + i % 26));
+        sent_payloads.push_back("datagram " + std::to_string(i) + filler);
+    }
+    std::vector<coro_ext::udp_batch::datagram> out = datagrams_of(sent_payloads);
+
+    auto scheduler = make_inline_scheduler();
+    coro_ext::udp_batch sender{coro_ext::udp_batch::options{.max_batch = 64}};
+    coro_ext::udp_batch receiver{coro_ext::udp_batch::options{.max_batch = 64}};
+    std::vector<int> sent_per_call;
+    std::vector<std::string> received;
+    std::vector<sockaddr_in> sources;
+    std::vector<coro::task<void>> tasks;
+    tasks.emplace_back(receive_all(scheduler, receiver, sockets.receiver, kDatagrams, received, sources));
+    tasks.emplace_back(send_all(scheduler, sender, sockets.sender, out, sent_per_call));
+    coro::sync_wait(coro::when_all(std::move(tasks)));
+
+    // The 1 MiB socket buffers hold everything, so only max_batch limits each call.
+    CHECK(sent_per_call == std::vector<int>{64, 64, 22});
+    CHECK(received == sent_payloads);
+    const sockaddr_in sender_address = local_address(sockets.sender);
+    REQUIRE(sources.size() == kDatagrams);
+    for (const sockaddr_in &source : sources) {
+        CHECK(source.sin_family == AF_INET);
+        CHECK(source.sin_port == sender_address.sin_port);
+        CHECK(source.sin_addr.s_addr == sender_address.sin_addr.s_addr);
+    }
+}
+
+TEST_CASE("udp_batch handles partial batches", "[coro_ext][udp_batch]") {
+    udp_pair sockets;
+    coro_ext::udp_batch batch{coro_ext::udp_batch::options{.max_batch = 4}};
+    std::vector<std::string> payloads{"one", "two", "three", "four", "five", "six"};
+    std::vector<coro_ext::udp_batch::datagram> out = datagrams_of(payloads);
+    std::vector<std::string> buffers(8, std::string(64, '\0'));
+    std::vector<coro_ext::udp_batch::datagram> in = datagrams_of(buffers);
+
+    SECTION("empty spans and an empty socket") {
+        CHECK(batch.send(sockets.sender, {}) == 0);
+        CHECK(batch.recv(sockets.receiver, {}) == 0);
+        CHECK(batch.recv(sockets.receiver, in) == 0);
+    }
+
+    SECTION("max_batch and the span size bound each call") {
+        // Six datagrams with max_batch 4: two sendmmsg calls.
+        CHECK(batch.send(sockets.sender, out) == 4);
+        CHECK(batch.send(sockets.sender, std::span{out}.subspan(4)) == 2);
+        REQUIRE(readable(sockets.receiver));
+        // A span shorter than what is pending takes only that many; the rest stays queued.
+        CHECK(batch.recv(sockets.receiver, std::span{in}.first(1)) == 1);
+        CHECK(std::string(in[0].data.data(), in[0].size) == "one");
+        // A span longer than max_batch is cut to max_batch.
+        REQUIRE(batch.recv(sockets.receiver, in) == 4);
+        for (int i = 0; i < 4; ++i) CHECK(std::string(in[i].data.data(), in[i].size) == payloads[i + 1]);
+        // Fewer pending than requested: recvmmsg returns what there is without blocking.
+        CHECK(batch.recv(sockets.receiver, in) == 1);
+        CHECK(std::string(in[0].data.data(), in[0].size) == "six");
+        CHECK(batch.recv(sockets.receiver, in) == 0);
+    }
+
+    SECTION("errors are returned as -errno") {
+        // No destination: the receiver socket is not connected and the datagram carries no address.
+        CHECK(batch.send(sockets.receiver, std::span{out}.first(1)) == -EDESTADDRREQ);
+        CHECK(batch.recv(-1, in) == -EBADF);
+    }
+}
+
+TEST_CASE("udp_batch reports truncated datagrams", "[coro_ext][udp_batch]") {
+    udp_pair sockets;
+    coro_ext::udp_batch batch;
+    std::vector<std::string> payloads{std::string(100, 'x'), "fits", std::string(16, 'y')};
+    std::vector<coro_ext::udp_batch::datagram> out = datagrams_of(payloads);
+    REQUIRE(batch.send(sockets.sender, out) == 3);
+    REQUIRE(readable(sockets.receiver));
+
+    std::vector<std::string> buffers(3, std::string(16, '\0'));
+    std::vector<coro_ext::udp_batch::datagram> in = datagrams_of(buffers);
+    // Left over from an earlier call: recv() resets it.
+    in[1].truncated = true;
+    REQUIRE(batch.recv(sockets.receiver, in) == 3);
+    CHECK(in[0].truncated);
+    CHECK(in[0].size == 16);
+    CHECK(std::string(in[0].data.data(), in[0].size) == std::string(16, 'x'));
+    CHECK_FALSE(in[1].truncated);
+    CHECK(std::string(in[1].data.data(), in[1].size) == "fits");
+    // Exactly the buffer size is not truncated.
+    CHECK_FALSE(in[2].truncated);
+    CHECK(in[2].size == 16);
+}
+
+TEST_CASE("udp_batch splits GSO sends and reports GRO segment sizes", "[coro_ext][udp_batch]") {
+    if (!coro_ext::udp_batch::gso_supported()) {
+        WARN("UDP_SEGMENT is not supported on this kernel; skipping");
+        return;
+    }
+    constexpr std::uint16_t kSegment = 500;
+    constexpr std::size_t kSegments = 4;
+    udp_pair sockets;
+    coro_ext::udp_batch batch;
+    std::string payload;
+    for (std::size_t i = 0; i < kSegments; ++i) payload += std::string(kSegment, static_cast<char>('a' + i));
+    std::vector<std::string> payloads{payload};
+    std::vector<coro_ext::udp_batch::datagram> out = datagrams_of(payloads);
+    out[0].segment_size = kSegment;
+
+    std::vector<std::string> buffers(kSegments, std::string(64 * 1024, '\0'));
+    std::vector<coro_ext::udp_batch::datagram> in = datagrams_of(buffers);
+
+    SECTION("without GRO every segment arrives as its own datagram") {
+        REQUIRE(batch.send(sockets.sender, out) == 1);
+        REQUIRE(readable(sockets.receiver));
+        REQUIRE(batch.recv(sockets.receiver, in) == static_cast<int>(kSegments));
+        for (std::size_t i = 0; i < kSegments; ++i) {
+            CHECK(in[i].size == kSegment);
+            CHECK(in[i].segment_size == 0);
+            CHECK(std::string(in[i].data.data(), in[i].size) == payload.substr(i * kSegment, kSegment));
+        }
+    }
+
+    SECTION("with GRO coalesced datagrams carry the segment size") {
+        if (!coro_ext::udp_batch::enable_gro(sockets.receiver)) {
+            WARN("UDP_GRO is not supported on this kernel; skipping");
+            return;
+        }
+        REQUIRE(batch.send(sockets.sender, out) == 1);
+        REQUIRE(readable(sockets.receiver));
+        // The kernel decides how much to coalesce; the bytes and their order are fixed either way.
+        std::string received;
+        while (received.size() < payload.size()) {
+            const int n = batch.recv(sockets.receiver, in);
+            REQUIRE(n > 0);
+            for (int i = 0; i < n; ++i) {
+                CHECK_FALSE(in[i].truncated);
+                if (in[i].size > kSegment) CHECK(in[i].segment_size == kSegment);
+                received.append(in[i].data.data(), in[i].size);
+            }
+        }
+        CHECK(received == payload);
+    }
+}
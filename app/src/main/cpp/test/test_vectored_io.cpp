@@ -0,0 +1,209 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/vectored_io.hpp"
+
+#include <coro/coro.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+std::shared_ptr<coro::io_scheduler> make_inline_scheduler() {
+    return coro::io_scheduler::make_shared(coro::io_scheduler::options{
+        .execution_strategy = coro::io_scheduler::execution_strategy_t::process_tasks_inline});
+}
+
+// A connected non-blocking stream pair with small socket buffers, so large writes only go through in pieces.
+struct socket_pair {
+    int fds[2] = {-1, -1};
+
+    socket_pair() {
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) != 0) return;
+        const int small = 4096;
+        ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+        ::setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+    }
+    ~socket_pair() {
+        close(0);
+        close(1);
+    }
+    void close(int side) {
+        if (fds[side] >= 0) ::close(fds[side]);
+        fds[side] = -1;
+    }
+};
+
+coro::task<void> write_parts(std::shared_ptr<coro::io_scheduler> scheduler, int fd, std::vector<std::string> &parts,
+                             std::int64_t &result) {
+    co_await scheduler->schedule();
+    std::vector<std::span<const char>> spans;
+    for (const auto &p : parts) spans.emplace_back(p.data(), p.size());
+    result = co_await coro_ext::write_all(scheduler, fd, spans);
+    co_return;
+}
+
+coro::task<void> read_parts(std::shared_ptr<coro::io_scheduler> scheduler, int fd, std::vector<std::string> &parts,
+                            std::int64_t &result) {
+    co_await scheduler->schedule();
+    std::vector<std::span<char>> spans;
+    for (auto &p : parts) spans.emplace_back(p.data(), p.size());
+    result = co_await coro_ext::read_exact(scheduler, fd, spans);
+    co_return;
+}
+
+// Sends `data`, waits `delay` so the peer is blocked on the rest, then closes `side` of `sockets`.
+coro::task<void> send_then_close(std::shared_ptr<coro::io_scheduler> scheduler, socket_pair &sockets, int side,
+                                 std::string_view data, std::chrono::milliseconds delay) {
+    co_await scheduler->schedule();
+    if (!data.empty()) ::send(sockets.fds[side], data.data(), data.size(), MSG_NOSIGNAL);
+    co_await scheduler->yield_for(delay);
+    sockets.close(side);
+    co_return;
+}
+
+std::string joined(const std::vector<std::string> &parts) {
+    std::string all;
+    for (const auto &p : parts) all += p;
+    return all;
+}
+
+// `count` parts of random sizes below `max_size`, a quarter of them empty; random bytes when `fill` is set.
+std::vector<std::string> random_parts(std::mt19937 &rng, std::size_t count, std::size_t max_size, bool fill) {
+    std::vector<std::string> parts(count);
+    for (auto &p : parts) {
+        p.resize(rng() % 4 == 0 ? 0 : rng() % max_size);
+        if (fill) {
+            for (auto &c : p) c = static_cast<char>(rng());
+        }
+    }
+    return parts;
+}
+
+// Trims or grows `parts` so they add up to exactly `total` bytes.
+void resize_to(std::vector<std::string> &parts, std::size_t total) {
+    for (auto &p : parts) {
+        if (p.size() > total) p.resize(total);
+        total -= p.size();
+    }
+    parts.back().resize(parts.back().size() + total);
+}
+
+} // namespace
+
+TEST_CASE("vectored_io moves many parts through partial writes and reads", "[coro_ext][vectored_io]") {
+    std::mt19937 rng{7};
+    // 300 parts (several calls at max_parts_per_call each) of up to 900 bytes through 4 KiB socket buffers: most
+    // sendmsg()/recvmsg() calls stop in the middle of a part.
+    auto out = random_parts(rng, 300, 900, true);
+    auto in = random_parts(rng, 170, 2000, false);
+    const std::string sent = joined(out);
+    resize_to(in, sent.size());
+    REQUIRE(out.size() > 2 * coro_ext::max_parts_per_call);
+
+    socket_pair sockets;
+    REQUIRE(sockets.fds[0] >= 0);
+    auto scheduler = make_inline_scheduler();
+    std::int64_t written = 0;
+    std::int64_t read = 0;
+    std::vector<coro::task<void>> tasks;
+    tasks.emplace_back(write_parts(scheduler, sockets.fds[0], out, written));
+    tasks.emplace_back(read_parts(scheduler, sockets.fds[1], in, read));
+    coro::sync_wait(coro::when_all(std::move(tasks)));
+
+    CHECK(written == static_cast<std::int64_t>(sent.size()));
+    CHECK(read == static_cast<std::int64_t>(sent.size()));
+    CHECK(joined(in) == sent);
+}
+
+TEST_CASE("vectored_io skips empty parts", "[coro_ext][vectored_io]") {
+    socket_pair sockets;
+    REQUIRE(sockets.fds[0] >= 0);
+    auto scheduler = make_inline_scheduler();
+    std::int64_t written = -1;
+    std::int64_t read = -1;
+
+    SECTION("no parts or only empty parts") {
+        std::vector<std::string> none;
+        std::vector<std::string> empty(100);
+        coro::sync_wait(write_parts(scheduler, sockets.fds[0], none, written));
+        CHECK(written == 0);
+        coro::sync_wait(write_parts(scheduler, sockets.fds[0], empty, written));
+        CHECK(written == 0);
+        coro::sync_wait(read_parts(scheduler, sockets.fds[1], empty, read));
+        CHECK(read == 0);
+    }
+
+    SECTION("one-byte parts between runs of empty ones") {
+        // 200 one-byte parts, each followed by two empty ones: 600 entries, of which max_parts_per_call non-empty
+        // ones go into each call.
+        std::vector<std::string> out;
+        std::vector<std::string> in;
+        for (int i = 0; i < 200; ++i) {
+            out.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+            out.emplace_back();
+            out.emplace_back();
+            in.emplace_back();
+            in.push_back(std::string(1, '\0'));
+            in.emplace_back();
+        }
+        coro::sync_wait(write_parts(scheduler, sockets.fds[0], out, written));
+        CHECK(written == 200);
+        coro::sync_wait(read_parts(scheduler, sockets.fds[1], in, read));
+        CHECK(read == 200);
+        CHECK(joined(in) == joined(out));
+    }
+}
+
+TEST_CASE("vectored_io reports a closed peer", "[coro_ext][vectored_io]") {
+    auto scheduler = make_inline_scheduler();
+
+    SECTION("read_exact returns the bytes read before the close") {
+        socket_pair sockets;
+        REQUIRE(sockets.fds[0] >= 0);
+        std::vector<std::string> header{std::string(4, '\0'), std::string(16, '\0')};
+        std::int64_t read = -1;
+        std::vector<coro::task<void>> tasks;
+        tasks.emplace_back(read_parts(scheduler, sockets.fds[1], header, read));
+        tasks.emplace_back(send_then_close(scheduler, sockets, 0, "abcdefgh", 20ms));
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+        CHECK(read == 8);
+        CHECK(header[0] == "abcd");
+        CHECK(header[1].substr(0, 4) == "efgh");
+
+        std::vector<std::string> more{std::string(8, '\0')};
+        coro::sync_wait(read_parts(scheduler, sockets.fds[1], more, read));
+        CHECK(read == 0);
+    }
+
+    SECTION("write_all fails with EPIPE instead of raising SIGPIPE") {
+        socket_pair sockets;
+        REQUIRE(sockets.fds[0] >= 0);
+        // More than the socket buffers hold, so the writer is waiting for space when the peer closes.
+        std::vector<std::string> out(8, std::string(64 * 1024, 'x'));
+        std::int64_t written = 0;
+        std::vector<coro::task<void>> tasks;
+        tasks.emplace_back(write_parts(scheduler, sockets.fds[0], out, written));
+        tasks.emplace_back(send_then_close(scheduler, sockets, 1, {}, 20ms));
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+        CHECK((written == -EPIPE || written == -ECONNRESET));
+
+        std::vector<std::string> again{"x"};
+        coro::sync_wait(write_parts(scheduler, sockets.fds[0], again, written));
+        CHECK(written == -EPIPE);
+    }
+}
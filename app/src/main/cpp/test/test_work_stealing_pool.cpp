@@ -0,0 +1,147 @@
+// All code comments are in English per repo policy.
+
+#include "catch_amalgamated.hpp"
+
+#include "coro_ext/work_stealing_pool.hpp"
+
+#include <coro/coro.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Resumes the awaiting coroutine through work_stealing_pool::resume(), i.e. through the worker's LIFO slot.
+struct resume_through_pool {
+    coro_ext::work_stealing_pool &pool;
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) noexcept { return pool.resume(handle); }
+    void await_resume() const noexcept {}
+};
+
+coro::task<void> count_once(coro_ext::work_stealing_pool &pool, std::atomic<std::uint32_t> &hits) {
+    co_await pool.schedule();
+    co_await pool.yield();
+    hits.fetch_add(1, std::memory_order_relaxed);
+    co_return;
+}
+
+coro::task<void> spawn_from_worker(
+    coro_ext::work_stealing_pool &pool, std::vector<std::atomic<std::uint32_t>> &hits) {
+    co_await pool.schedule();
+    std::vector<coro::task<void>> children;
+    for (auto &h : hits) children.emplace_back(count_once(pool, h));
+    co_await coro::when_all(std::move(children));
+    co_return;
+}
+
+coro::task<void> hop_chain(
+    coro_ext::work_stealing_pool &pool, std::uint32_t hops, std::atomic<std::uint32_t> &done_hops) {
+    co_await pool.schedule();
+    for (std::uint32_t i = 0; i < hops; ++i) {
+        co_await resume_through_pool{pool};
+        done_hops.store(i + 1, std::memory_order_relaxed);
+    }
+    co_return;
+}
+
+coro::task<void> record_hops(coro_ext::work_stealing_pool &pool, const std::atomic<std::uint32_t> &done_hops,
+                             std::uint32_t &seen) {
+    co_await pool.schedule();
+    seen = done_hops.load(std::memory_order_relaxed);
+    co_return;
+}
+
+coro::task<void> shut_down_from_worker(coro_ext::work_stealing_pool &pool, std::atomic<std::uint32_t> &hits) {
+    co_await pool.schedule();
+    pool.shutdown();
+    // Still on the worker, which keeps running (and draining) after shutdown() returned.
+    co_await pool.schedule();
+    hits.fetch_add(1, std::memory_order_relaxed);
+    co_return;
+}
+
+coro::task<void> yield_loop(coro_ext::work_stealing_pool &pool, std::uint32_t yields,
+                            std::atomic<std::uint32_t> &finished) {
+    co_await pool.schedule();
+    for (std::uint32_t i = 0; i < yields; ++i) co_await pool.yield();
+    finished.fetch_add(1, std::memory_order_relaxed);
+    co_return;
+}
+
+coro::task<std::thread::id> schedule_and_report(coro_ext::work_stealing_pool &pool) {
+    co_await pool.schedule();
+    co_return std::this_thread::get_id();
+}
+
+} // namespace
+
+TEST_CASE("work_stealing_pool runs every task exactly once when deques overflow and get stolen",
+          "[coro_ext][work_stealing_pool]") {
+    // Tiny deques force overflow into the injection queue; the children all start on one worker, so the others
+    // only get work by stealing from it.
+    coro_ext::work_stealing_pool pool{coro_ext::work_stealing_pool::options{.thread_count = 4,
+                                                                            .local_queue_capacity = 4}};
+    std::vector<std::atomic<std::uint32_t>> hits(5000);
+    coro::sync_wait(spawn_from_worker(pool, hits));
+    std::uint32_t wrong = 0;
+    for (const auto &h : hits) wrong += h.load() != 1 ? 1 : 0;
+    REQUIRE(wrong == 0);
+}
+
+TEST_CASE("work_stealing_pool caps LIFO slot streaks so queued work is not starved",
+          "[coro_ext][work_stealing_pool]") {
+    // One worker: the chain always re-enters the LIFO slot, so the other task only runs once the streak is cut.
+    coro_ext::work_stealing_pool pool{coro_ext::work_stealing_pool::options{.thread_count = 1}};
+    constexpr std::uint32_t kHops = 10'000;
+    std::atomic<std::uint32_t> done_hops{0};
+    std::uint32_t seen = kHops;
+    std::vector<coro::task<void>> tasks;
+    tasks.emplace_back(hop_chain(pool, kHops, done_hops));
+    tasks.emplace_back(record_hops(pool, done_hops, seen));
+    coro::sync_wait(coro::when_all(std::move(tasks)));
+    REQUIRE(done_hops.load() == kHops);
+    REQUIRE(seen < 100);
+}
+
+TEST_CASE("work_stealing_pool shutdown with work in flight still runs every coroutine",
+          "[coro_ext][work_stealing_pool]") {
+    for (int round = 0; round < 20; ++round) {
+        coro_ext::work_stealing_pool pool{coro_ext::work_stealing_pool::options{.thread_count = 2}};
+        constexpr std::uint32_t kTasks = 64;
+        std::atomic<std::uint32_t> finished{0};
+        std::thread driver{[&] {
+            std::vector<coro::task<void>> tasks;
+            for (std::uint32_t i = 0; i < kTasks; ++i) tasks.emplace_back(yield_loop(pool, 200, finished));
+            coro::sync_wait(coro::when_all(std::move(tasks)));
+        }};
+        std::this_thread::sleep_for(std::chrono::microseconds(50 * round));
+        pool.shutdown();
+        driver.join();
+        REQUIRE(finished.load() == kTasks);
+    }
+}
+
+TEST_CASE("work_stealing_pool resumes inline after shutdown", "[coro_ext][work_stealing_pool]") {
+    coro_ext::work_stealing_pool pool{coro_ext::work_stealing_pool::options{.thread_count = 2}};
+    pool.shutdown();
+    REQUIRE(coro::sync_wait(schedule_and_report(pool)) == std::this_thread::get_id());
+}
+
+TEST_CASE("work_stealing_pool can be destroyed after shutdown from one of its workers",
+          "[coro_ext][work_stealing_pool]") {
+    std::atomic<std::uint32_t> hits{0};
+    for (int round = 0; round < 50; ++round) {
+        auto pool = std::make_unique<coro_ext::work_stealing_pool>(coro_ext::work_stealing_pool::options{
+            .thread_count = 2});
+        coro::sync_wait(shut_down_from_worker(*pool, hits));
+        // The worker that called shutdown() may still be inside worker_loop(); the destructor waits for it.
+        pool.reset();
+    }
+    REQUIRE(hits.load() == 50);
+}
@@ -0,0 +1,234 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+// TLS client/server helpers for the tls_session_cache tests and benchmarks:
+//  - a self-signed certificate generated in memory, as a server SSL_CTX or as PEM files for net::tls::context (so the
+//    tests do not depend on cert.pem/key.pem);
+//  - client/server SSL pairs joined by a BIO pair, for cache behaviour without sockets;
+//  - a net::tls::server loop and a net::tls::client request for loopback connections through libcoro.
+
+#include "coro_ext/record_buffer_pool.hpp"
+
+#include <coro/coro.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace tls_loopback {
+
+struct ssl_ctx_deleter {
+    void operator()(SSL_CTX *ctx) const { SSL_CTX_free(ctx); }
+};
+using ssl_ctx_ptr = std::unique_ptr<SSL_CTX, ssl_ctx_deleter>;
+
+struct ssl_deleter {
+    void operator()(SSL *ssl) const { SSL_free(ssl); }
+};
+using ssl_ptr = std::unique_ptr<SSL, ssl_deleter>;
+
+struct pkey_deleter {
+    void operator()(EVP_PKEY *key) const { EVP_PKEY_free(key); }
+};
+struct x509_deleter {
+    void operator()(X509 *cert) const { X509_free(cert); }
+};
+
+// Self-signed P-256 certificate for CN=localhost, generated in memory.
+struct self_signed {
+    std::unique_ptr<EVP_PKEY, pkey_deleter> key{EVP_EC_gen("P-256")};
+    std::unique_ptr<X509, x509_deleter> cert{X509_new()};
+
+    self_signed() {
+        if (!key || !cert) return;
+        ASN1_INTEGER_set(X509_get_serialNumber(cert.get()), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert.get()), 0);
+        X509_gmtime_adj(X509_getm_notAfter(cert.get()), 3600);
+        X509_set_pubkey(cert.get(), key.get());
+        X509_NAME *name = X509_get_subject_name(cert.get());
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("localhost"), -1,
+                                   -1, 0);
+        X509_set_issuer_name(cert.get(), name);
+        if (X509_sign(cert.get(), key.get(), EVP_sha256()) <= 0) cert.reset();
+    }
+
+    explicit operator bool() const noexcept { return key && cert; }
+
+    // Writes the certificate and key as PEM, for net::tls::context.
+    bool write_pem(const std::string &cert_path, const std::string &key_path) const {
+        std::FILE *cert_file = std::fopen(cert_path.c_str(), "w");
+        std::FILE *key_file = std::fopen(key_path.c_str(), "w");
+        bool ok = cert_file && key_file && PEM_write_X509(cert_file, cert.get()) == 1 &&
+                  PEM_write_PrivateKey(key_file, key.get(), nullptr, nullptr, 0, nullptr, nullptr) == 1;
+        if (cert_file) ok = std::fclose(cert_file) == 0 && ok;
+        if (key_file) ok = std::fclose(key_file) == 0 && ok;
+        return ok;
+    }
+};
+
+// Server context with a fresh self-signed certificate. max_version 0 allows every TLS version.
+inline ssl_ctx_ptr make_server_ctx(int max_version = 0) {
+    ssl_ctx_ptr ctx{SSL_CTX_new(TLS_server_method())};
+    const self_signed identity;
+    const bool ok = ctx && identity && SSL_CTX_use_certificate(ctx.get(), identity.cert.get()) == 1 &&
+                    SSL_CTX_use_PrivateKey(ctx.get(), identity.key.get()) == 1 &&
+                    (max_version == 0 || SSL_CTX_set_max_proto_version(ctx.get(), max_version) == 1);
+    return ok ? std::move(ctx) : nullptr;
+}
+
+inline ssl_ctx_ptr make_client_ctx() {
+    ssl_ctx_ptr ctx{SSL_CTX_new(TLS_client_method())};
+    if (ctx) SSL_CTX_set_verify(ctx.get(), SSL_VERIFY_NONE, nullptr); // self-signed test server
+    return ctx;
+}
+
+// A client and a server SSL joined by a BIO pair; the client sends SNI "localhost".
+struct connection {
+    ssl_ptr client;
+    ssl_ptr server;
+
+    connection(SSL_CTX *client_ctx, SSL_CTX *server_ctx)
+        : client(SSL_new(client_ctx)), server(SSL_new(server_ctx)) {
+        BIO *client_bio = nullptr;
+        BIO *server_bio = nullptr;
+        if (!client || !server || BIO_new_bio_pair(&client_bio, 0, &server_bio, 0) != 1) {
+            client.reset();
+            server.reset();
+            return;
+        }
+        SSL_set_bio(client.get(), client_bio, client_bio);
+        SSL_set_bio(server.get(), server_bio, server_bio);
+        SSL_set_connect_state(client.get());
+        SSL_set_accept_state(server.get());
+        SSL_set_tlsext_host_name(client.get(), "localhost");
+    }
+
+    explicit operator bool() const noexcept { return client && server; }
+
+    bool handshake() {
+        for (int round = 0; round < 64; ++round) {
+            const int rc_client = SSL_do_handshake(client.get());
+            const int rc_server = SSL_do_handshake(server.get());
+            if (rc_client == 1 && rc_server == 1) return true;
+            const int err_client = rc_client == 1 ? SSL_ERROR_NONE : SSL_get_error(client.get(), rc_client);
+            const int err_server = rc_server == 1 ? SSL_ERROR_NONE : SSL_get_error(server.get(), rc_server);
+            const auto retryable = [](int err) {
+                return err == SSL_ERROR_NONE || err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE;
+            };
+            if (!retryable(err_client) || !retryable(err_server)) return false;
+        }
+        return false;
+    }
+
+    // Lets the client process the TLS 1.3 NewSessionTicket messages the server sent after the handshake.
+    void read_tickets() {
+        char byte = 0;
+        SSL_read(client.get(), &byte, 1);
+    }
+
+    bool resumed() const { return SSL_session_reused(client.get()) == 1; }
+
+    void close() {
+        SSL_shutdown(client.get());
+        SSL_shutdown(server.get());
+    }
+};
+
+// Reads exactly data.size() bytes; false when the connection fails or closes first.
+inline coro::task<bool> recv_exact(std::shared_ptr<coro::io_scheduler> scheduler, coro::net::tls::client &client,
+                                   std::span<char> data) {
+    co_await scheduler->schedule();
+    while (!data.empty()) {
+        auto [status, received] = co_await client.recv(data);
+        if (status != coro::net::tls::recv_status::ok || received.empty()) co_return false;
+        data = data.subspan(received.size());
+    }
+    co_return true;
+}
+
+inline coro::task<bool> send_all(std::shared_ptr<coro::io_scheduler> scheduler, coro::net::tls::client &client,
+                                 std::span<const char> data) {
+    co_await scheduler->schedule();
+    while (!data.empty()) {
+        auto [status, rest] = co_await client.send(data);
+        if (status != coro::net::tls::send_status::ok) co_return false;
+        data = rest;
+    }
+    co_return true;
+}
+
+// Accepts connections one at a time until net_stop(). Each connection sends a 4-byte response size; the server
+// answers with that many bytes, sent from a buffer leased from `buffers`, and waits for the client to close first so
+// the client's session is shut down cleanly (and stays resumable).
+inline coro::task<void> net_serve(std::shared_ptr<coro::io_scheduler> scheduler, coro::net::tls::server &server,
+                                  coro_ext::record_buffer_pool &buffers, const std::atomic<bool> &stop) {
+    co_await scheduler->schedule();
+    for (;;) {
+        if (co_await server.poll() != coro::poll_status::event) co_return;
+        auto client = co_await server.accept();
+        if (stop.load(std::memory_order_acquire)) co_return;
+        if (!client.socket().is_valid()) continue;
+        std::uint32_t response_size = 0;
+        const std::span<char> request{reinterpret_cast<char *>(&response_size), sizeof(response_size)};
+        if (!co_await recv_exact(scheduler, client, request)) continue;
+        auto buffer = buffers.acquire();
+        std::fill_n(buffer.data(), buffer.size(), 'x');
+        bool ok = true;
+        for (std::size_t left = response_size; ok && left > 0;) {
+            const std::size_t n = std::min(left, buffer.size());
+            ok = co_await send_all(scheduler, client, std::span<const char>{buffer.data(), n});
+            left -= n;
+        }
+        if (ok) co_await client.recv(buffer.span());
+    }
+}
+
+// One connection to 127.0.0.1:port: connects, requests response_size bytes and reads them into a buffer leased from
+// `buffers`. Returns the bytes received, or -1 when the connection or the exchange fails.
+inline coro::task<std::int64_t> net_request(std::shared_ptr<coro::io_scheduler> scheduler,
+                                            std::shared_ptr<coro::net::tls::context> ctx, std::uint16_t port,
+                                            std::uint32_t response_size, coro_ext::record_buffer_pool &buffers) {
+    co_await scheduler->schedule();
+    coro::net::tls::client client{
+        scheduler, std::move(ctx),
+        coro::net::tls::client::options{.address = coro::net::ip_address::from_string("127.0.0.1"), .port = port}};
+    if (co_await client.connect() != coro::net::tls::connection_status::connected) co_return -1;
+    const std::span<const char> request{reinterpret_cast<const char *>(&response_size), sizeof(response_size)};
+    if (!co_await send_all(scheduler, client, request)) co_return -1;
+    auto buffer = buffers.acquire();
+    std::int64_t received = 0;
+    while (received < response_size) {
+        const std::size_t want = std::min<std::size_t>(buffer.size(), response_size - received);
+        auto [status, data] = co_await client.recv(std::span<char>{buffer.data(), want});
+        if (status != coro::net::tls::recv_status::ok || data.empty()) co_return -1;
+        received += static_cast<std::int64_t>(data.size());
+    }
+    co_return received;
+}
+
+// Makes net_serve() return: sets `stop`, then wakes the server's poll() with a plain TCP connection that closes
+// without a handshake, so stopping works even when TLS connections fail.
+inline void net_stop(std::atomic<bool> &stop, std::uint16_t port) {
+    stop.store(true, std::memory_order_release);
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    ::close(fd);
+}
+
+} // namespace tls_loopback
@@ -0,0 +1,17 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <string>
+
+// Per-test resource instrumentation (test_metrics_listener.cpp).
+// A Catch2 event listener records, for every test case: wall time, user/system CPU time, voluntary/involuntary
+// context switches, RSS at start and peak RSS growth, heap allocation count, the number of threads created during the
+// test (thread_counter.hpp) and the process thread count before and after it (/proc/self/status Threads).
+// Rows are appended to a CSV file and flushed per test, so a shard killed on timeout still leaves its data behind.
+
+// Set the CSV output path before the Catch2 session runs; an empty path disables the listener.
+void test_metrics_set_output(const std::string &path);
+
+// Appends the rows of `part` (header skipped) to `dest`, creating dest with the header if needed, then removes part.
+// Used to merge per-shard files into one.
+bool test_metrics_merge(const std::string &dest, const std::string &part);
@@ -0,0 +1,177 @@
+// All code comments are in English per repo policy.
+
+#include "../../../../external/libcoro/test/catch_amalgamated.hpp"
+#include "alloc_counter.hpp"
+#include "test_metrics.hpp"
+#include "thread_counter.hpp"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace {
+
+std::string g_output_path;
+
+const char kCsvHeader[] = "test_case,tags,result,wall_ms,user_cpu_ms,sys_cpu_ms,voluntary_ctx_switches,"
+                          "involuntary_ctx_switches,rss_start_kib,peak_rss_delta_kib,allocations,threads_created,"
+                          "threads_before,threads_after";
+
+struct ProcStatus {
+    long rss_kib = 0;
+    long hwm_kib = 0;
+    long threads = 0;
+};
+
+// VmRSS / VmHWM / Threads from /proc/self/status.
+ProcStatus read_proc_status() {
+    ProcStatus st;
+    std::FILE *f = std::fopen("/proc/self/status", "r");
+    if (!f) return st;
+    char line[256];
+    while (std::fgets(line, sizeof(line), f)) {
+        if (std::strncmp(line, "VmRSS:", 6) == 0) {
+            st.rss_kib = std::strtol(line + 6, nullptr, 10);
+        } else if (std::strncmp(line, "VmHWM:", 6) == 0) {
+            st.hwm_kib = std::strtol(line + 6, nullptr, 10);
+        } else if (std::strncmp(line, "Threads:", 8) == 0) {
+            st.threads = std::strtol(line + 8, nullptr, 10);
+        }
+    }
+    std::fclose(f);
+    return st;
+}
+
+// Resets VmHWM to the current RSS (Linux 4.0+). Returns false where /proc/self/clear_refs is not writable.
+bool reset_peak_rss() {
+    std::FILE *f = std::fopen("/proc/self/clear_refs", "w");
+    if (!f) return false;
+    bool ok = std::fputs("5", f) >= 0;
+    ok = (std::fclose(f) == 0) && ok;
+    return ok;
+}
+
+double timeval_ms(const timeval &tv) {
+    return static_cast<double>(tv.tv_sec) * 1e3 + static_cast<double>(tv.tv_usec) / 1e3;
+}
+
+std::string csv_field(const std::string &s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) return s;
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+    return out;
+}
+
+class TestMetricsListener : public Catch::EventListenerBase {
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void testRunStarting(const Catch::TestRunInfo &) override {
+        if (g_output_path.empty()) return;
+        out_ = std::fopen(g_output_path.c_str(), "w");
+        if (out_) {
+            std::fputs(kCsvHeader, out_);
+            std::fputc('\n', out_);
+            std::fflush(out_);
+        }
+    }
+
+    void testRunEnded(const Catch::TestRunStats &) override {
+        if (out_) std::fclose(out_);
+        out_ = nullptr;
+    }
+
+    void testCaseStarting(const Catch::TestCaseInfo &) override {
+        if (!out_) return;
+        start_status_ = read_proc_status();
+        hwm_reset_ = reset_peak_rss();
+        getrusage(RUSAGE_SELF, &start_usage_);
+        start_allocs_ = alloc_counter::allocations();
+        start_threads_created_ = thread_counter::created();
+        start_time_ = std::chrono::steady_clock::now();
+    }
+
+    void testCaseEnded(const Catch::TestCaseStats &stats) override {
+        if (!out_) return;
+        const auto end_time = std::chrono::steady_clock::now();
+        const auto allocs = alloc_counter::allocations() - start_allocs_;
+        // Counted at creation, so threads a test starts and joins again (e.g. a scheduler it builds and destroys)
+        // show up; Threads from /proc/self/status only gives the count at each end of the test.
+        const auto threads_created = thread_counter::created() - start_threads_created_;
+        rusage end_usage{};
+        getrusage(RUSAGE_SELF, &end_usage);
+        const ProcStatus end_status = read_proc_status();
+
+        // With a reset high-water mark VmHWM is the peak reached during this test; otherwise fall back to the
+        // growth of the process-lifetime maximum.
+        long peak_rss_delta = hwm_reset_ ? end_status.hwm_kib - start_status_.rss_kib
+                                         : end_usage.ru_maxrss - start_usage_.ru_maxrss;
+        if (peak_rss_delta < 0) peak_rss_delta = 0;
+
+        const double wall_ms = std::chrono::duration<double, std::milli>(end_time - start_time_).count();
+        std::fprintf(
+            out_,
+            "%s,%s,%s,%.3f,%.3f,%.3f,%ld,%ld,%ld,%ld,%llu,%llu,%ld,%ld\n",
+            csv_field(stats.testInfo->name).c_str(),
+            csv_field(stats.testInfo->tagsAsString()).c_str(),
+            stats.totals.assertions.failed == 0 ? "passed" : "failed",
+            wall_ms,
+            timeval_ms(end_usage.ru_utime) - timeval_ms(start_usage_.ru_utime),
+            timeval_ms(end_usage.ru_stime) - timeval_ms(start_usage_.ru_stime),
+            end_usage.ru_nvcsw - start_usage_.ru_nvcsw,
+            end_usage.ru_nivcsw - start_usage_.ru_nivcsw,
+            start_status_.rss_kib,
+            peak_rss_delta,
+            static_cast<unsigned long long>(allocs),
+            static_cast<unsigned long long>(threads_created),
+            start_status_.threads,
+            end_status.threads);
+        std::fflush(out_);
+    }
+
+private:
+    std::FILE *out_ = nullptr;
+    ProcStatus start_status_;
+    bool hwm_reset_ = false;
+    rusage start_usage_{};
+    std::uint64_t start_allocs_ = 0;
+    std::uint64_t start_threads_created_ = 0;
+    std::chrono::steady_clock::time_point start_time_;
+};
+
+CATCH_REGISTER_LISTENER(TestMetricsListener)
+
+} // namespace
+
+void test_metrics_set_output(const std::string &path) {
+    g_output_path = path;
+}
+
+bool test_metrics_merge(const std::string &dest, const std::string &part) {
+    std::ifstream in(part);
+    if (!in.is_open()) return false;
+    const bool dest_exists = static_cast<bool>(std::ifstream(dest));
+    std::ofstream out(dest, std::ios::app);
+    if (!out.is_open()) return false;
+    std::string line;
+    bool first = true;
+    while (std::getline(in, line)) {
+        if (first) {
+            first = false;
+            if (dest_exists) continue; // header already present
+        }
+        out << line << '\n';
+    }
+    in.close();
+    std::remove(part.c_str());
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,30 @@
+// All code comments are in English per repo policy.
+
+#include "thread_counter.hpp"
+
+#include <pthread.h>
+
+#include <atomic>
+
+namespace {
+
+std::atomic<std::uint64_t> g_created{0};
+
+} // namespace
+
+namespace thread_counter {
+
+std::uint64_t created() noexcept {
+    return g_created.load(std::memory_order_relaxed);
+}
+
+} // namespace thread_counter
+
+// --wrap=pthread_create binds references to pthread_create to __wrap_pthread_create and __real_pthread_create to libc.
+extern "C" int __real_pthread_create(pthread_t *thread, const pthread_attr_t *attr, void *(*start)(void *), void *arg);
+
+extern "C" int __wrap_pthread_create(pthread_t *thread, const pthread_attr_t *attr, void *(*start)(void *), void *arg) {
+    const int rc = __real_pthread_create(thread, attr, start, arg);
+    if (rc == 0) g_created.fetch_add(1, std::memory_order_relaxed);
+    return rc;
+}
@@ -0,0 +1,15 @@
+// All code comments are in English per repo policy.
+#pragma once
+
+#include <cstdint>
+
+// Process-wide thread creation counter.
+// Linking thread_counter.cpp together with -Wl,--wrap=pthread_create routes every pthread_create call made from the
+// linked objects through a counting wrapper. That covers std::thread (libc++ creates threads from its headers) and
+// the schedulers of the statically linked libcoro. Threads created by other shared libraries (the JVM) are not counted.
+namespace thread_counter {
+
+// Total number of successful pthread_create calls since process start (all threads).
+std::uint64_t created() noexcept;
+
+} // namespace thread_counter
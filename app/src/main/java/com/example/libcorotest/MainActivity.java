@@ -67,7 +67,7 @@ public class MainActivity extends Activity {
         }, "tests").start();
     }
 
-    // Called from native
+    // Called from native once per batch; s may hold several lines separated by newlines.
     public void appendLine(String s) {
         if (Looper.myLooper() == Looper.getMainLooper()) {
             textView.append(s + "\n");
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""Compare coroBench JSON results against a stored baseline.
+
+Exits with status 1 when any benchmark regresses beyond the threshold:
+  - ops_per_sec drops by more than --threshold percent
+  - sample_p99_ns (p99 of the per-sample means) grows by more than --p99-threshold percent
+  - allocs_per_op grows by more than --alloc-slack allocations
+Benchmarks present in only one of the files are reported but never fail the check.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, 'r') as f:
+        doc = json.load(f)
+    return {(b['test_case'], b['name']): b for b in doc.get('benchmarks', [])}
+
+
+def p99(bench):
+    # Schema 1 files called the percentile of per-sample means p99_ns.
+    return bench.get('sample_p99_ns', bench.get('p99_ns', 0.0))
+
+
+def pct(new, old):
+    if old == 0:
+        return 0.0
+    return (new - old) / old * 100.0
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('baseline')
+    ap.add_argument('current')
+    ap.add_argument('--threshold', type=float, default=10.0, help='max ops/sec drop in percent (default 10)')
+    ap.add_argument('--p99-threshold', type=float, default=25.0, help='max p99 growth in percent (default 25)')
+    ap.add_argument('--alloc-slack', type=float, default=0.5, help='max allocs/op growth (default 0.5)')
+    args = ap.parse_args()
+
+    base = load(args.baseline)
+    cur = load(args.current)
+
+    regressions = 0
+    print(f"{'benchmark':60} {'ops/s':>14} {'delta':>8} {'p99 smpl ns':>12} {'delta':>8} {'allocs/op':>10}")
+    for key in sorted(cur):
+        c = cur[key]
+        label = f"{key[0]} / {key[1]}"[:60]
+        b = base.get(key)
+        if b is None:
+            print(f"{label:60} {c['ops_per_sec']:14.1f} {'new':>8} {p99(c):12.1f} {'':>8} {c['allocs_per_op']:10.2f}")
+            continue
+        d_ops = pct(c['ops_per_sec'], b['ops_per_sec'])
+        d_p99 = pct(p99(c), p99(b))
+        d_alloc = c['allocs_per_op'] - b['allocs_per_op']
+        failed = []
+        if d_ops < -args.threshold:
+            failed.append('throughput')
+        if d_p99 > args.p99_threshold:
+            failed.append('p99')
+        if d_alloc > args.alloc_slack:
+            failed.append('allocs')
+        mark = '  REGRESSION: ' + ', '.join(failed) if failed else ''
+        print(f"{label:60} {c['ops_per_sec']:14.1f} {d_ops:+7.1f}% {p99(c):12.1f} {d_p99:+7.1f}% "
+              f"{c['allocs_per_op']:10.2f}{mark}")
+        if failed:
+            regressions += 1
+
+    for key in sorted(set(base) - set(cur)):
+        print(f"{key[0]} / {key[1]}: missing from current results")
+
+    if regressions:
+        print(f"\n{regressions} benchmark(s) regressed against {args.baseline}")
+        return 1
+    print("\nNo regressions against baseline.")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())